@@ -0,0 +1,394 @@
+//! @file bench_http_server.cpp
+//! @brief The benchmark of the http server, the load generator of the loopback measures the throughput and the latency
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// boost
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <boost/log/core.hpp>
+#include <boost/program_options.hpp>
+
+// this
+#include <cmntype/http/http_response.h>
+#include <cmntype/http/http_server.h>
+#include <cmntype/http/metrics.h>
+
+namespace
+{
+namespace asio = boost::asio;
+namespace beast_http = boost::beast::http;
+namespace http = common::http;
+
+/// @brief Options of the benchmark
+struct Options
+{
+  std::string address;
+  std::uint16_t port{0};
+  std::uint16_t threads{0};
+  std::uint16_t clients{0};
+  std::size_t connections{0};
+  /// @brief count of the requests of the connection waiting for the response
+  std::size_t pipeline{0};
+  /// @brief the connection is opened for each request
+  bool close{false};
+  std::size_t requestBody{0};
+  std::size_t responseBody{0};
+  std::chrono::seconds warmup{0};
+  std::chrono::seconds duration{0};
+  std::string target;
+};
+
+/// @brief State of the load shared by the connections
+struct Load
+{
+  /// @brief the requests are counted after the warm-up
+  std::atomic<bool> counting{false};
+  std::atomic<bool> stop{false};
+  std::atomic<std::uint64_t> errors{0};
+};
+
+/// @brief Connection of the load generator.
+///
+/// The keep-alive connection keeps the pipeline full: the new requests are written together
+/// as the responses arrive. The latency of the request is the time from its write to its response,
+/// the connection per request includes the connect.
+class Connection final : public std::enable_shared_from_this<Connection>
+{
+  using Clock = std::chrono::steady_clock;
+
+public:
+  Connection(asio::io_context& io, const asio::ip::tcp::endpoint& endpoint, const Options& options, Load& load)
+    : socket_{asio::make_strand(io)}
+    , endpoint_{endpoint}
+    , load_{load}
+    , pipeline_{options.close ? 1 : std::max<std::size_t>(options.pipeline, 1)}
+    , close_{options.close}
+  {
+    beast_http::request<beast_http::string_body> request{options.requestBody ? beast_http::verb::post : beast_http::verb::get,
+        options.target, 11};
+    request.set(beast_http::field::host, endpoint.address().to_string());
+    request.keep_alive(!close_);
+    if (options.requestBody)
+    {
+      request.set(beast_http::field::content_type, "application/octet-stream");
+      request.body().assign(options.requestBody, 'x');
+    }
+    request.prepare_payload();
+
+    std::ostringstream os;
+    os << request;
+    request_ = os.str();
+  }
+
+  void Start()
+  {
+    Connect();
+  }
+
+  /// @brief Latency of the counted requests, microseconds
+  const http::Histogram& Latency() const noexcept
+  {
+    return latency_;
+  }
+
+private:
+  void Connect()
+  {
+    connected_ = Clock::now();
+    socket_.async_connect(endpoint_, [self = shared_from_this()](boost::beast::error_code ec)
+        {
+          if (self->Failed(ec))
+          {
+            return;
+          }
+          self->DoWrite();
+        });
+  }
+
+  void DoWrite()
+  {
+    if (writing_ || load_.stop || inflight_ == pipeline_)
+    {
+      return;
+    }
+
+    out_.clear();
+    const auto now = close_ ? connected_ : Clock::now();
+    for (; inflight_ < pipeline_; inflight_++)
+    {
+      out_ += request_;
+      sent_.push_back(now);
+    }
+
+    writing_ = true;
+    asio::async_write(socket_, asio::buffer(out_), [self = shared_from_this()](boost::beast::error_code ec, std::size_t)
+        {
+          self->writing_ = false;
+          if (self->Failed(ec))
+          {
+            return;
+          }
+          self->DoWrite();
+        });
+
+    DoRead();
+  }
+
+  void DoRead()
+  {
+    if (reading_ || !inflight_)
+    {
+      return;
+    }
+
+    parser_.emplace();
+    parser_->body_limit(boost::none);
+
+    reading_ = true;
+    beast_http::async_read(socket_, buffer_, *parser_, [self = shared_from_this()](boost::beast::error_code ec, std::size_t)
+        {
+          self->reading_ = false;
+          self->HandleRead(ec);
+        });
+  }
+
+  void HandleRead(boost::beast::error_code ec)
+  {
+    if (Failed(ec))
+    {
+      return;
+    }
+
+    if (beast_http::status::ok != parser_->get().result())
+    {
+      load_.errors++;
+      socket_.close(ec);
+      return;
+    }
+
+    if (load_.counting)
+    {
+      const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sent_.front());
+      latency_.Add(http::Histogram::Index(static_cast<std::uint64_t>(latency.count())), 1);
+    }
+    sent_.pop_front();
+    inflight_--;
+
+    if (close_)
+    {
+      socket_.close(ec);
+      if (!load_.stop)
+      {
+        Connect();
+      }
+      return;
+    }
+
+    if (load_.stop && !inflight_)
+    {
+      socket_.close(ec);
+      return;
+    }
+
+    DoWrite();
+    DoRead();
+  }
+
+  bool Failed(boost::beast::error_code ec)
+  {
+    if (!ec)
+    {
+      return false;
+    }
+
+    if (asio::error::operation_aborted != ec)
+    {
+      load_.errors++;
+    }
+    socket_.close(ec);
+    return true;
+  }
+
+private:
+  asio::ip::tcp::socket socket_;
+  asio::ip::tcp::endpoint endpoint_;
+  Load& load_;
+  const std::size_t pipeline_;
+  const bool close_;
+  /// @brief serialized request
+  std::string request_;
+  /// @brief requests of the current write
+  std::string out_;
+  std::deque<Clock::time_point> sent_;
+  std::size_t inflight_{0};
+  bool writing_{false};
+  bool reading_{false};
+  Clock::time_point connected_;
+  boost::beast::flat_buffer buffer_;
+  std::optional<beast_http::response_parser<beast_http::string_body>> parser_;
+  http::Histogram latency_;
+};
+
+const char* ToString(http::Configuration::IoBackend backend)
+{
+  switch (backend)
+  {
+    case http::Configuration::IoBackend::io_uring:
+      return "io_uring";
+    case http::Configuration::IoBackend::epoll:
+      return "epoll";
+    default:
+      return "automatic";
+  }
+}
+
+bool ParseOptions(int argc, char* argv[], Options& options)
+{
+  namespace po = boost::program_options;
+
+  unsigned warmup{0};
+  unsigned duration{0};
+
+  po::options_description description("Options");
+  description.add_options()
+    ("help,h", "print the help")
+    ("address", po::value(&options.address)->default_value("127.0.0.1"), "address of the server")
+    ("port", po::value(&options.port)->default_value(18080), "port of the server")
+    ("threads", po::value(&options.threads)->default_value(2), "io threads of the server")
+    ("clients", po::value(&options.clients)->default_value(2), "io threads of the load generator")
+    ("connections", po::value(&options.connections)->default_value(64), "connections of the load generator")
+    ("pipeline", po::value(&options.pipeline)->default_value(1), "requests of the connection waiting for the response")
+    ("close", po::bool_switch(&options.close), "open the connection for each request instead of the keep-alive")
+    ("request-body", po::value(&options.requestBody)->default_value(0), "size of the request body, POST if not 0")
+    ("response-body", po::value(&options.responseBody)->default_value(64), "size of the response body")
+    ("warmup", po::value(&warmup)->default_value(1), "warm-up, seconds")
+    ("duration", po::value(&duration)->default_value(10), "measurement, seconds")
+    ("target", po::value(&options.target)->default_value("/template"),
+        "route: /template (constant response) or /handler (response of the handler)");
+
+  po::variables_map vm;
+  po::store(po::parse_command_line(argc, argv, description), vm);
+  po::notify(vm);
+
+  if (vm.count("help"))
+  {
+    std::cout << description << std::endl;
+    return false;
+  }
+
+  if (options.requestBody && "/handler" != options.target)
+  {
+    throw std::invalid_argument("the request body is sent only to /handler");
+  }
+
+  options.warmup = std::chrono::seconds(warmup);
+  options.duration = std::chrono::seconds(duration);
+  return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+      return 0;
+    }
+
+    // the log of the requests isn't measured
+    boost::log::core::get()->set_logging_enabled(false);
+
+    const std::string body(options.responseBody, 'x');
+    const auto handler = [&body](const http::HttpRequest& request)
+        {
+          return http::MakeResponse(request, beast_http::status::ok, "application/octet-stream", "UTF-8", std::string(body));
+        };
+
+    http::Configuration config;
+    config.pipelineLimit = std::max<std::size_t>(options.pipeline, config.pipelineLimit);
+    config.bodyLimit = std::max<std::uint64_t>(options.requestBody, config.bodyLimit);
+    // the benchmark measures the server, not zlib
+    config.compression.enabled = false;
+
+    http::HttpServer server{options.address, options.port, options.threads, config};
+    server.AddResponse("/template", beast_http::verb::get,
+        http::MakeResponseTemplate(beast_http::status::ok, "application/octet-stream", "UTF-8", body));
+    server.AddRequestHandler("/handler", beast_http::verb::get, handler);
+    server.AddRequestHandler("/handler", beast_http::verb::post, handler);
+    server.Start();
+
+    asio::io_context io{options.clients};
+    const asio::ip::tcp::endpoint endpoint{asio::ip::make_address(options.address), options.port};
+
+    Load load;
+    std::vector<std::shared_ptr<Connection>> connections;
+    for (std::size_t i = 0; i < options.connections; i++)
+    {
+      connections.push_back(std::make_shared<Connection>(io, endpoint, options, load));
+      connections.back()->Start();
+    }
+
+    std::vector<std::thread> threads;
+    for (std::uint16_t i = 0; i < options.clients; i++)
+    {
+      threads.emplace_back([&io] { io.run(); });
+    }
+
+    std::this_thread::sleep_for(options.warmup);
+    load.counting = true;
+    const auto start = std::chrono::steady_clock::now();
+    std::this_thread::sleep_for(options.duration);
+    load.counting = false;
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // the connections stop after the responses of the sent requests
+    load.stop = true;
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    server.Stop();
+
+    http::Histogram latency;
+    for (const auto& connection : connections)
+    {
+      latency.Merge(connection->Latency());
+    }
+
+    std::cout << "backend: " << ToString(http::HttpServer::GetIoBackend()) << ", server threads: " << options.threads
+      << ", client threads: " << options.clients << std::endl
+      << "target: " << options.target << ", connections: " << options.connections
+      << (options.close ? ", close" : ", keep-alive, pipeline: " + std::to_string(std::max<std::size_t>(options.pipeline, 1)))
+      << ", request body: " << options.requestBody << ", response body: " << options.responseBody << std::endl
+      << "requests: " << latency.Count() << ", errors: " << load.errors << ", duration: "
+      << std::fixed << std::setprecision(2) << elapsed << " s" << std::endl
+      << "rps: " << static_cast<std::uint64_t>(latency.Count() / elapsed) << std::endl
+      << "latency, us: p50 " << latency.Quantile(0.5) << ", p99 " << latency.Quantile(0.99)
+      << ", p999 " << latency.Quantile(0.999) << std::endl;
+
+    return load.errors ? 1 : 0;
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << "Benchmark failed: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,25 @@
+#!/bin/bash
+
+# compare_io_backends: Build the benchmark with epoll and io_uring and run both on the same workload
+#   ./bench/compare_io_backends.sh [options of the benchmark]
+
+set -e
+
+source_dir=$(cd "$(dirname "$0")/.." && pwd)
+
+for backend in epoll io_uring; do
+  build_dir="${source_dir}/build-bench-${backend}"
+  io_uring=OFF
+  if [ "${backend}" == "io_uring" ]; then
+    io_uring=ON
+  fi
+
+  cmake -S "${source_dir}" -B "${build_dir}" -DBUILD_WITHOUT_TESTS=ON \
+    -DBUILD_BENCHMARKS=ON -DBUILD_WITH_IO_URING=${io_uring} ${CMAKE_OPTIONS} > /dev/null
+  cmake --build "${build_dir}" --target cmntype_bench -j"$(nproc)" > /dev/null
+done
+
+for backend in epoll io_uring; do
+  echo "--- ${backend}"
+  "${source_dir}/build-bench-${backend}/cmntype_bench" "$@"
+done
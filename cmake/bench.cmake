@@ -0,0 +1,26 @@
+# benchmark of the http server, the load is generated over the loopback.
+# The library is built into the benchmark with the optimization and without the coverage, whatever the build type is
+add_executable(${ProjectName}_bench ${INCLUDES} ${SOURCES} bench/bench_http_server.cpp)
+target_compile_options(${ProjectName}_bench
+  PUBLIC
+  $<$<CXX_COMPILER_ID:Clang>: -O2 -DNDEBUG -Wall>
+  $<$<CXX_COMPILER_ID:GNU>: -O2 -DNDEBUG -Wall>
+  )
+
+if (MSVC)
+    target_compile_options(${ProjectName}_bench PUBLIC "/Zc:__cplusplus" /O2 /DNDEBUG)
+    target_compile_features(${ProjectName}_bench PUBLIC cxx_std_17)
+endif()
+
+target_include_directories(${ProjectName}_bench
+  PRIVATE
+  $<BUILD_INTERFACE:${CMAKE_CURRENT_SOURCE_DIR}/inc>
+  $<BUILD_INTERFACE:${CURL_INCLUDE_DIRS}>
+  $<BUILD_INTERFACE:${Boost_INCLUDE_DIRS}>
+  )
+
+if (BUILD_WITH_IO_URING)
+    target_include_directories(${ProjectName}_bench PRIVATE ${URING_INCLUDE_DIR})
+endif()
+
+target_link_libraries(${ProjectName}_bench ${LIBRARIES})
@@ -0,0 +1,94 @@
+//! @file admission.h
+//! @brief The declare admission control of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// this
+#include <cmntype/http/config.h>
+
+namespace common
+{
+namespace http
+{
+/// @brief Current counts of the http server
+struct ServerStats
+{
+  /// @brief open connections
+  std::size_t connections{0};
+  /// @brief requests in flight
+  std::size_t requests{0};
+  /// @brief open long-lived streams
+  std::size_t streams{0};
+  /// @brief connections rejected by the limit
+  std::uint64_t rejectedConnections{0};
+  /// @brief pauses of the accept by the limit
+  std::uint64_t pausedAccepts{0};
+  /// @brief requests rejected by the limit
+  std::uint64_t rejectedRequests{0};
+};
+
+/// @class Admission
+/// @brief Counters of the connections and the requests in flight with the limits,
+/// the admitted unit is released by the destruction of its ticket
+class Admission final
+{
+public:
+  /// @class Ticket
+  /// @brief The admitted connection or request
+  class Ticket final
+  {
+  public:
+    Ticket() = default;
+    explicit Ticket(std::atomic<std::size_t>* counter) noexcept;
+    Ticket(Ticket&& other) noexcept;
+    Ticket& operator=(Ticket&& other) noexcept;
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket();
+    explicit operator bool() const noexcept { return counter_ != nullptr; }
+    void Reset() noexcept;
+
+  private:
+    std::atomic<std::size_t>* counter_{nullptr};
+  };
+
+public:
+  explicit Admission(const Configuration::Limits& limits);
+  Admission(const Admission&) = delete;
+  Admission& operator=(const Admission&) = delete;
+  /// @brief Admit the connection, the empty ticket if the limit is reached
+  Ticket AdmitConnection() noexcept;
+  /// @brief Admit the request, the empty ticket if the limit is reached
+  Ticket AdmitRequest() noexcept;
+  /// @brief Admit the long-lived stream, the empty ticket if the limit is reached
+  Ticket AdmitStream() noexcept;
+  /// @brief Count the request without the limit, the drain waits for the streams ended by it
+  Ticket HoldRequest() noexcept;
+  /// @brief The limit of the connections is reached
+  bool IsFull() const noexcept;
+  /// @brief Count the pause of the accept
+  void Pause() noexcept;
+  ServerStats GetStats() const noexcept;
+  const Configuration::Limits& Limits() const noexcept { return limits_; }
+
+private:
+  static Ticket Admit(std::atomic<std::size_t>& counter, std::size_t limit, std::atomic<std::uint64_t>& rejected) noexcept;
+
+private:
+  Configuration::Limits limits_;
+  std::atomic<std::size_t> connections_{0};
+  std::atomic<std::size_t> requests_{0};
+  std::atomic<std::size_t> streams_{0};
+  std::atomic<std::uint64_t> rejectedConnections_{0};
+  std::atomic<std::uint64_t> rejectedRequests_{0};
+  std::atomic<std::uint64_t> pausedAccepts_{0};
+};
+}  // namespace http
+}  // namespace common
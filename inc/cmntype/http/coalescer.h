@@ -0,0 +1,74 @@
+//! @file coalescer.h
+//! @brief The declare coalescing of the concurrent identical requests of the route
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+// this
+#include <cmntype/http/responder.h>
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class Coalescer
+/// @brief The flights of the handler of the route (single-flight).
+///
+/// The first request of the key starts the flight and calls the handler with the responder of the flight,
+/// the next requests of the key join the flight and wait. The response of the handler is sent to all
+/// requests of the flight, the flight is finished by the response. If the handler drops the responder
+/// without the response, the waiting requests are answered 'internal server error' by their responders.
+/// The flights are split into shards with own locks, so the threads rarely contend.
+class Coalescer final : public std::enable_shared_from_this<Coalescer>
+{
+public:
+  explicit Coalescer(const CoalesceOptions& options);
+  Coalescer(const Coalescer&) = delete;
+  Coalescer& operator=(const Coalescer&) = delete;
+  /// @brief Key of the request
+  std::string Key(const HttpRequest& request) const;
+  /// @brief Join the flight of the key
+  /// @param key - key of the request
+  /// @param request - request, its version and keep-alive are set to the shared response
+  /// @param responder - responder of the request
+  /// @return responder of the new flight, the handler must be called with it;
+  /// empty if the request joined the flight in progress
+  std::optional<Responder> Join(const std::string& key, const HttpRequest& request, Responder responder);
+  /// @brief Count of the flights in progress
+  std::size_t Size() const;
+  /// @brief Count of the requests served by the flights of the other requests
+  std::uint64_t Coalesced() const noexcept { return coalesced_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr std::size_t shardCount_{8};
+
+  class Flight;
+
+  struct Shard
+  {
+    mutable std::mutex m;
+    std::unordered_map<std::string, Flight*> flights;
+  };
+
+  Shard& GetShard(const std::string& key);
+
+private:
+  CoalesceOptions options_;
+  std::array<Shard, shardCount_> shards_;
+  std::atomic<std::uint64_t> coalesced_{0};
+};
+}  // namespace http
+}  // namespace common
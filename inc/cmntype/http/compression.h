@@ -0,0 +1,93 @@
+//! @file compression.h
+//! @brief The declare compression of the response body
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// this
+#include <cmntype/http/config.h>
+#include <cmntype/http/shared_body.h>
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @brief Content coding of the body
+enum class ContentCoding
+{
+  identity,
+  gzip,
+  deflate
+};
+
+/// @brief Choose the coding by the value of 'Accept-Encoding' (q-values are supported, gzip is preferred)
+ContentCoding NegotiateCoding(std::string_view acceptEncoding);
+
+/// @brief Compress the data
+/// @param data - data
+/// @param coding - gzip (RFC 1952) or deflate (zlib format, RFC 1950)
+/// @param level - level of the compression
+std::string Compress(std::string_view data, ContentCoding coding, int level);
+
+/// @class Compressor
+/// @brief Compression of the response body, is shared by the sessions.
+///
+/// The compressed bodies of the cacheable routes are kept in the LRU cache, the entry is found
+/// by the hash of the body and its uncompressed body is compared, so the hot responses are compressed once.
+/// The compressed body is shared by the entry and the readers, it is copied outside the lock.
+class Compressor final
+{
+public:
+  using Body = std::shared_ptr<const std::string>;
+
+public:
+  explicit Compressor(const Configuration::Compression& options);
+  Compressor(const Compressor&) = delete;
+  Compressor& operator=(const Compressor&) = delete;
+  /// @brief Compress the body of the response if the client accepts it
+  /// @param request - request
+  /// @param response - response, the body and the headers are replaced, the strong ETag of the compressed body is weakened
+  /// @param cacheable - the compressed body is cached
+  void Apply(const HttpRequest& request, HttpResponse& response, bool cacheable) const;
+  /// @brief Compress the shared body of the response, the cached entry refers to the owner of the body
+  void Apply(const HttpRequest& request, SharedResponse& response, bool cacheable) const;
+  /// @brief Count of the cached bodies
+  std::size_t CacheSize() const;
+
+private:
+  struct Entry
+  {
+    ContentCoding coding;
+    /// @brief the uncompressed body, the collision of the hash isn't served
+    SharedBody::value_type body;
+    Body compressed;
+    std::list<std::size_t>::iterator lru;
+  };
+
+  /// @brief The coding of the body accepted by the client, identity if the body isn't compressed
+  ContentCoding Negotiate(const HttpRequest& request, HttpResponseHeader& header, std::size_t size) const;
+  /// @brief The compressed body from the cache, the body is compressed and stored if it isn't found
+  /// @param uncompressed - the shared body for the entry, the body without the owner is copied
+  Body Cached(std::string_view body, ContentCoding coding, SharedBody::value_type uncompressed) const;
+  Body Find(std::size_t key, ContentCoding coding, std::string_view body) const;
+  void Store(std::size_t key, ContentCoding coding, SharedBody::value_type body, Body compressed) const;
+
+private:
+  Configuration::Compression options_;
+  mutable std::mutex m_;
+  mutable std::unordered_map<std::size_t, Entry> entries_;
+  mutable std::list<std::size_t> lru_;
+};
+}  // namespace http
+}  // namespace common
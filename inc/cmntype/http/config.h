@@ -0,0 +1,138 @@
+//! @file config.h
+//! @brief The configuration of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace common
+{
+namespace http
+{
+/// @struct Configuration
+/// @brief The configuration of the http server
+struct Configuration
+{
+  /// @brief Model of the io threads
+  enum class Threading
+  {
+    /// @brief one io_context and one acceptor are shared by all threads
+    shared,
+    /// @brief each thread owns io_context and acceptor bound with SO_REUSEPORT,
+    /// the connections are spread by the kernel and a session never leaves its thread
+    per_thread
+  };
+
+  /// @brief Backend of the io contexts, the backend is chosen at the build (see BUILD_WITH_IO_URING)
+  enum class IoBackend
+  {
+    /// @brief backend of the build
+    automatic,
+    /// @brief reactor on epoll (the native reactor on the other platforms)
+    epoll,
+    /// @brief completions of io_uring (Linux 5.10+)
+    io_uring
+  };
+
+  /// @brief Compression of the response body negotiated by 'Accept-Encoding'
+  struct Compression
+  {
+    /// @brief the responses are compressed, off by default to keep the body of the existing routes as is
+    bool enabled{false};
+    /// @brief minimum size of the body, the smaller bodies are sent as is
+    std::size_t minSize{1024};
+    /// @brief level of the compression (1 - fastest, 9 - best)
+    int level{6};
+    /// @brief maximum count of the cached compressed bodies of the cacheable routes
+    std::size_t cacheSize{256};
+  };
+
+  /// @brief Admission control under the overload, 0 - unlimited
+  struct Limits
+  {
+    /// @brief Behaviour when the limit of the connections is reached
+    enum class Overload
+    {
+      /// @brief the connection is accepted and closed after the response 503
+      reject,
+      /// @brief the accept is paused, the connections wait in the backlog of the socket
+      pause
+    };
+
+    /// @brief maximum count of the open connections
+    std::size_t connections{0};
+    /// @brief maximum count of the requests in flight (the header is read, the response isn't written),
+    /// the exceeding requests are rejected with 503
+    std::size_t requests{0};
+    /// @brief maximum count of the open long-lived streams (server-sent events), the streams aren't requests
+    /// in flight, each of them holds the connection; the exceeding streams are rejected with 503
+    std::size_t streams{0};
+    Overload overload{Overload::reject};
+    /// @brief value of the header 'Retry-After' of the response 503
+    std::chrono::seconds retryAfter{1};
+    /// @brief interval of the check of the paused accept
+    std::chrono::milliseconds acceptPause{10};
+  };
+
+  /// @brief Timeouts of the session, the session is closed after the timeout
+  struct Timeouts
+  {
+    /// @brief reading of the header of the first request
+    std::chrono::milliseconds header{std::chrono::seconds(10)};
+    /// @brief reading of the request body
+    std::chrono::milliseconds body{std::chrono::seconds(30)};
+    /// @brief waiting for the next request of the keep-alive connection
+    std::chrono::milliseconds idle{std::chrono::seconds(60)};
+    /// @brief writing of the response (is restarted by the progress of the streamed response)
+    std::chrono::milliseconds write{std::chrono::seconds(30)};
+    /// @brief resolution of the timer wheel, the timeouts are checked with this step
+    std::chrono::milliseconds resolution{250};
+    /// @brief waiting for the requests in flight on the stop of the server, the rest are dropped
+    std::chrono::milliseconds drain{std::chrono::seconds(5)};
+  };
+
+  /// @brief Metrics of the routes: counts, bytes and latency
+  struct Metrics
+  {
+    bool enabled{true};
+    /// @brief route of the metrics in the text format of Prometheus ('/metrics' etc), empty - no route
+    std::string path;
+  };
+
+  /// @brief TLS of the listener (HTTPS), the files are in the PEM format
+  struct Tls
+  {
+    bool enabled{false};
+    /// @brief file of the certificate chain
+    std::string certificate;
+    /// @brief file of the private key
+    std::string privateKey;
+    /// @brief size of the server-side cache of the sessions for the resumption by the session id, 0 - no cache
+    std::size_t sessionCacheSize{20 * 1024};
+    /// @brief lifetime of the cached sessions and the tickets
+    std::chrono::seconds sessionTimeout{300};
+    /// @brief stateless resumption by the session tickets
+    bool tickets{true};
+  };
+
+  Threading threading{Threading::shared};
+  /// @brief Backend of the io, the server isn't created if the backend isn't built
+  IoBackend ioBackend{IoBackend::automatic};
+  /// @brief Maximum count of the pipelined requests of the session waiting for the response
+  std::size_t pipelineLimit{8};
+  /// @brief Default maximum size of the request body, the larger requests are rejected with 413
+  std::uint64_t bodyLimit{1024 * 1024};
+  Compression compression;
+  Limits limits;
+  Timeouts timeouts;
+  Metrics metrics;
+  Tls tls;
+};
+}  // namespace http
+}  // namespace common
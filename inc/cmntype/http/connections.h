@@ -0,0 +1,64 @@
+//! @file connections.h
+//! @brief The declare registry of the open connections of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace common
+{
+namespace http
+{
+/// @class Connections
+/// @brief The open connections (http and WebSocket sessions), so the stop of the server reaches
+/// the sessions kept alive by the handlers of the application.
+///
+/// The registry doesn't own the connections, the closed ones are dropped by the next additions.
+/// The connections are spread over the shards by the accepting thread.
+class Connections final
+{
+public:
+  /// @class Connection
+  /// @brief The connection of the registry
+  class Connection
+  {
+  public:
+    virtual ~Connection() = default;
+    /// @brief Close the socket, is called when the io threads of the server are stopped
+    virtual void Abort() noexcept = 0;
+    /// @brief End the long-lived streams of the connection, is called by the drain from any thread
+    virtual void Shutdown() = 0;
+  };
+
+public:
+  Connections() = default;
+  Connections(const Connections&) = delete;
+  Connections& operator=(const Connections&) = delete;
+  void Add(const std::shared_ptr<Connection>& connection);
+  /// @brief Call the function for each open connection, the function is called without the lock
+  void ForEach(const std::function<void(Connection&)>& function) const;
+
+private:
+  static constexpr std::size_t shardCount_ = 8;
+  static constexpr std::size_t minPrune_ = 64;
+
+  struct alignas(64) Shard
+  {
+    mutable std::mutex m;
+    std::vector<std::weak_ptr<Connection>> connections;
+    /// @brief the closed connections are dropped when the size reaches the limit
+    std::size_t prune{minPrune_};
+  };
+
+  std::array<Shard, shardCount_> shards_;
+};
+}  // namespace http
+}  // namespace common
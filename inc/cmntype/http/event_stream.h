@@ -0,0 +1,89 @@
+//! @file event_stream.h
+//! @brief The declare stream of the server-sent events
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// this
+#include <cmntype/http/response_writer.h>
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @brief Options of the route of the server-sent events
+struct EventStreamOptions
+{
+  /// @brief maximum size of the events waiting for the write, the stream of the slow client
+  /// over the limit is closed (the client reconnects with 'Last-Event-ID')
+  std::size_t bufferLimit{1024 * 1024};
+};
+
+/// @class EventStream
+/// @brief The stream of the server-sent events (text/event-stream) of one client.
+///
+/// The stream may be copied and used from any thread. While the previous write is in progress,
+/// the new events are appended to one buffer and written by the next write, so the slow client
+/// gets fewer larger writes. The stream is completed by Close() or when all copies are destroyed.
+class EventStream final
+{
+  class State;
+
+public:
+  explicit EventStream(ResponseWriter writer, const EventStreamOptions& options = {});
+  /// @brief Send the event
+  /// @param data - data of the event, the lines are sent as the separate 'data' fields
+  /// @param event - type of the event, empty - 'message'
+  /// @param id - identifier of the event
+  /// @return false if the stream is closed
+  bool Send(std::string_view data, std::string_view event = {}, std::string_view id = {}) const;
+  /// @brief Complete the stream
+  void Close() const;
+  bool IsOpen() const noexcept;
+  /// @brief Format the event in the text/event-stream format
+  static std::string Format(std::string_view data, std::string_view event = {}, std::string_view id = {});
+
+private:
+  friend class EventChannel;
+  bool Push(std::string_view formatted) const;
+
+private:
+  std::shared_ptr<State> state_;
+};
+
+/// @class EventChannel
+/// @brief Broadcast of the events to the joined streams, the event is formatted once.
+/// The channel doesn't own the streams, the closed streams leave the channel on the next publish.
+class EventChannel final
+{
+public:
+  EventChannel() = default;
+  EventChannel(const EventChannel&) = delete;
+  EventChannel& operator=(const EventChannel&) = delete;
+  void Join(const EventStream& stream);
+  /// @brief Send the event to all streams of the channel
+  /// @return count of the streams
+  std::size_t Publish(std::string_view data, std::string_view event = {}, std::string_view id = {});
+  /// @brief Count of the streams (with the closed ones, which haven't left yet)
+  std::size_t Size() const;
+
+private:
+  mutable std::mutex m_;
+  std::vector<std::weak_ptr<EventStream::State>> streams_;
+};
+
+/// @brief Handler of the route of the server-sent events, the stream is opened before the call
+using EventStreamHandler = std::function<void(const HttpRequest& request, EventStream stream)>;
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,93 @@
+//! @file file_cache.h
+//! @brief The declare cache of the open files
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// boost
+#include <boost/beast/core/error.hpp>
+
+namespace common
+{
+namespace http
+{
+/// @class File
+/// @brief The open file and its attributes, the descriptor is shared by the sessions
+/// and read only with the explicit offset (sendfile, pread)
+class File final
+{
+public:
+  File(int handle, std::uint64_t size, std::uint64_t inode, std::time_t modified);
+  File(const File&) = delete;
+  File& operator=(const File&) = delete;
+  ~File();
+  int Handle() const noexcept { return handle_; }
+  std::uint64_t Size() const noexcept { return size_; }
+  std::uint64_t Inode() const noexcept { return inode_; }
+  std::time_t Modified() const noexcept { return modified_; }
+  /// @brief value of the header 'ETag'
+  const std::string& ETag() const noexcept { return etag_; }
+  /// @brief value of the header 'Last-Modified'
+  const std::string& LastModified() const noexcept { return lastModified_; }
+
+private:
+  int handle_;
+  std::uint64_t size_;
+  std::uint64_t inode_;
+  std::time_t modified_;
+  std::string etag_;
+  std::string lastModified_;
+};
+
+/// @class FileCache
+/// @brief The LRU cache of the open file descriptors.
+///
+/// The entry is revalidated by stat() after the interval, the changed file is reopened.
+class FileCache final
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using FilePtr = std::shared_ptr<const File>;
+
+public:
+  FileCache(std::size_t capacity, Clock::duration revalidate);
+  FileCache(const FileCache&) = delete;
+  FileCache& operator=(const FileCache&) = delete;
+  /// @brief Open the regular file or get it from the cache
+  /// @param path - path of the file
+  /// @param ec - error of the opening
+  FilePtr Open(const std::string& path, boost::beast::error_code& ec);
+  /// @brief Count of the cached files
+  std::size_t Size() const;
+
+private:
+  struct Entry
+  {
+    FilePtr file;
+    Clock::time_point checked;
+    std::list<std::string>::iterator lru;
+  };
+
+  static FilePtr OpenFile(const std::string& path, boost::beast::error_code& ec);
+
+private:
+  std::size_t capacity_;
+  Clock::duration revalidate_;
+  mutable std::mutex m_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::list<std::string> lru_;
+};
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,152 @@
+//! @file handler_allocator.h
+//! @brief The declare recycling allocator of the handlers and the sessions
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// boost
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associated_executor.hpp>
+
+namespace common
+{
+namespace http
+{
+/// @class RecyclingPool
+/// @brief The per-thread cache of the freed memory blocks by the size classes.
+///
+/// The blocks are taken from the cache of the calling thread without the locks, the freed block
+/// goes to the cache of the thread which frees it. The blocks over the largest class and over
+/// the limit of the cache are passed to the global operator new/delete.
+class RecyclingPool final
+{
+public:
+  /// @brief the smallest size class, the classes are the powers of two
+  static constexpr std::size_t minSize = 64;
+  /// @brief count of the size classes (64 bytes - 16 KB)
+  static constexpr std::size_t classCount = 9;
+  /// @brief maximum count of the cached blocks of one class
+  static constexpr std::size_t cacheLimit = 16;
+
+  static void* Allocate(std::size_t size);
+  static void Deallocate(void* pointer, std::size_t size) noexcept;
+};
+
+/// @class HandlerAllocator
+/// @brief The allocator (std::allocator interface) of the recycling pool, all instances are equal
+template <class T>
+class HandlerAllocator
+{
+public:
+  using value_type = T;
+
+  HandlerAllocator() noexcept = default;
+  template <class U>
+  HandlerAllocator(const HandlerAllocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(RecyclingPool::Allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* pointer, std::size_t n) noexcept
+  {
+    RecyclingPool::Deallocate(pointer, n * sizeof(T));
+  }
+
+  template <class U>
+  bool operator==(const HandlerAllocator<U>&) const noexcept
+  {
+    return true;
+  }
+
+  template <class U>
+  bool operator!=(const HandlerAllocator<U>&) const noexcept
+  {
+    return false;
+  }
+};
+
+/// @class RecyclingHandler
+/// @brief The completion handler with the associated recycling allocator, the operations of asio and beast
+/// allocate their state from the pool instead of the heap. The associated executor of the handler is kept.
+template <class Handler>
+class RecyclingHandler
+{
+public:
+  using allocator_type = HandlerAllocator<void>;
+
+  explicit RecyclingHandler(Handler handler)
+    : handler_{std::move(handler)}
+  {
+  }
+
+  allocator_type get_allocator() const noexcept
+  {
+    return {};
+  }
+
+  const Handler& Get() const noexcept
+  {
+    return handler_;
+  }
+
+  template <class... Args>
+  void operator()(Args&&... args)
+  {
+    handler_(std::forward<Args>(args)...);
+  }
+
+private:
+  Handler handler_;
+};
+
+/// @brief Make the handler with the recycling allocator
+template <class Handler>
+RecyclingHandler<std::decay_t<Handler>> MakeRecyclingHandler(Handler&& handler)
+{
+  return RecyclingHandler<std::decay_t<Handler>>{std::forward<Handler>(handler)};
+}
+
+/// @brief Base of the objects allocated from the recycling pool (the type-erased works etc),
+/// the derived type is freed with its own size by the virtual destructor
+struct Recycled
+{
+  static void* operator new(std::size_t size)
+  {
+    return RecyclingPool::Allocate(size);
+  }
+
+  static void operator delete(void* pointer, std::size_t size) noexcept
+  {
+    RecyclingPool::Deallocate(pointer, size);
+  }
+};
+}  // namespace http
+}  // namespace common
+
+namespace boost
+{
+namespace asio
+{
+template <class Handler, class Executor>
+struct associated_executor<common::http::RecyclingHandler<Handler>, Executor>
+{
+  using type = associated_executor_t<Handler, Executor>;
+
+  static type get(const common::http::RecyclingHandler<Handler>& handler, const Executor& executor = Executor{}) noexcept
+  {
+    return associated_executor<Handler, Executor>::get(handler.Get(), executor);
+  }
+};
+}  // namespace asio
+}  // namespace boost
@@ -7,15 +7,33 @@
 #pragma once
 
 // std
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <vector>
 
 // this
+#include <cmntype/http/shared_body.h>
 #include <cmntype/http/types.h>
 
 namespace common
 {
 namespace http
 {
+/// @brief The overloads with the body moved in are selected only by the rvalue std::string,
+/// the literals and the views are copied by the overloads with std::string_view
+template <class String>
+using IfMovedString = std::enable_if_t<std::is_same_v<String, std::string>, int>;
+
+/// @brief Make response without body
+/// @param request - request
+/// @param status - status of response
+/// @param contentType - type content, 'application/json' etc
+/// @param encoding - encoding data
+/// @return response
+HttpResponse MakeResponse(const HttpRequest& request,
+    boost::beast::http::status status,
+    std::string_view contentType, std::string_view encoding);
 
 /// @brief Make response from
 /// @param request - request
@@ -29,6 +47,26 @@ HttpResponse MakeResponse(const HttpRequest& request,
     std::string_view contentType, std::string_view encoding,
     std::string_view data);
 
+/// @brief Make response with the body moved in
+template <class String, IfMovedString<String> = 0>
+HttpResponse MakeResponse(const HttpRequest& request,
+    boost::beast::http::status status,
+    std::string_view contentType, std::string_view encoding,
+    String&& data)
+{
+  auto response = MakeResponse(request, status, contentType, encoding);
+  response.body() = std::move(data);
+  response.prepare_payload();
+  return response;
+}
+
+/// @brief Make response with the body in the external buffer, the buffer is written without the copy
+/// @param body - buffer of the body and its owner
+SharedResponse MakeSharedResponse(const HttpRequest& request,
+    boost::beast::http::status status,
+    std::string_view contentType, std::string_view encoding,
+    SharedBody::value_type body);
+
 /// @breif Make response for bad request
 HttpResponse MakeResponseForBadRequest(const HttpRequest& request,
     std::string_view contentType, std::string_view encoding,
@@ -39,16 +77,64 @@ HttpResponse MakeResponseForNotFound(const HttpRequest& request,
     std::string_view contentType, std::string_view encoding,
     std::string_view data);
 
+/// @brief Make response for not found with the body moved in
+template <class String, IfMovedString<String> = 0>
+HttpResponse MakeResponseForNotFound(const HttpRequest& request,
+    std::string_view contentType, std::string_view encoding,
+    String&& data)
+{
+  return MakeResponse(request, boost::beast::http::status::not_found, contentType, encoding, std::move(data));
+}
+
 /// `@brief Make response for server error
 HttpResponse MakeResponseForServerError(const HttpRequest& request, 
     std::string_view contentType, std::string_view encoding,
     std::string_view data);
 
+/// @brief Make response for server error with the body moved in
+template <class String, IfMovedString<String> = 0>
+HttpResponse MakeResponseForServerError(const HttpRequest& request,
+    std::string_view contentType, std::string_view encoding,
+    String&& data)
+{
+  return MakeResponse(request, boost::beast::http::status::internal_server_error, contentType, encoding, std::move(data));
+}
+
+/// @brief Make response for payload too large, the connection is closed after the response
+HttpResponse MakeResponseForPayloadTooLarge(const HttpRequest& request,
+    std::string_view contentType, std::string_view encoding,
+    std::string_view data);
+
+/// @brief Make response for bad request with the body moved in
+template <class String, IfMovedString<String> = 0>
+HttpResponse MakeResponseForBadRequest(const HttpRequest& request,
+    std::string_view contentType, std::string_view encoding,
+    String&& data)
+{
+  return MakeResponse(request, boost::beast::http::status::bad_request, contentType, encoding, std::move(data));
+}
+
 /// @brief Make response for not allowed
 HttpResponse MakeResponseForNotAllowed(const HttpRequest& request, 
     std::string_view contentType, std::string_view encoding,
     std::string_view data);
 
+/// @brief Make response for not modified (without body)
+/// @param request - request
+/// @param etag - entity tag of the resource
+HttpResponse MakeResponseForNotModified(const HttpRequest& request, std::string_view etag);
+
+/// @brief Check the header 'If-None-Match' of the request
+/// @param request - request
+/// @param etag - entity tag of the resource
+/// @return true if the client has the same resource
+bool IsNotModified(const HttpRequest& request, std::string_view etag);
+
+/// @brief Make key of the request, the requests with the same key get the same response
+/// @param request - request
+/// @param vary - headers of the request changing the response, 'Accept-Language' etc
+/// @return the method, the target and the values of the headers
+std::string MakeRequestKey(const HttpRequest& request, const std::vector<std::string>& vary);
 
 }
 }
@@ -8,6 +8,7 @@
 // std
 #include <memory>
 #include <cstddef>
+#include <string>
 #include <string_view>
 #include <functional>
 #include <thread>
@@ -19,7 +20,14 @@
 #include <boost/beast.hpp>
 
 // this
+#include <cmntype/http/admission.h>
+#include <cmntype/http/config.h>
+#include <cmntype/http/event_stream.h>
+#include <cmntype/http/response_template.h>
+#include <cmntype/http/static_files.h>
 #include <cmntype/http/types.h>
+#include <cmntype/http/websocket.h>
+#include <cmntype/thread/pool_thread.h>
 
 namespace common
 {
@@ -30,14 +38,65 @@ class HttpServer final
 {
 public:
   explicit HttpServer(const std::string_view address, std::uint16_t port, std::uint16_t threads);
+  HttpServer(const std::string_view address, std::uint16_t port, std::uint16_t threads, const Configuration& config);
   HttpServer(const HttpServer&) = delete;
   HttpServer& operator=(const HttpServer&) = delete;
   HttpServer(HttpServer&&);
   HttpServer& operator=(HttpServer&&);
   ~HttpServer();
+  /// @brief Start the listeners and the io threads, the server may be started again after the stop
   void Start();
+  /// @brief Drain the requests in flight and close the connections. The io contexts live as long as the server,
+  /// so the sessions kept by the handlers of the application (Responder, ResponseWriter) may be released after the stop
   void Stop();
-  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler);
+  /// @brief Current counts of the connections and the requests
+  ServerStats GetStats() const;
+  /// @brief Counts, bytes and latency of the routes in the text format of Prometheus
+  std::string GetMetrics() const;
+  /// @brief Backend of the io of the build
+  static Configuration::IoBackend GetIoBackend() noexcept;
+  /// @brief Add handler of the route
+  /// @param uri - route, '/geo/{id}', '/static/*' etc (see Router)
+  /// @param method - method of the request
+  /// @param handler - handler of the request
+  /// @param options - options of the route
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler,
+      const RouteOptions& options = {});
+  /// @brief Add handler of the route with the parameters
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RouteRequestHandler handler,
+      const RouteOptions& options = {});
+  /// @brief Add asynchronous handler, the handler must not block the io thread
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, AsyncRequestHandler handler,
+      const RouteOptions& options = {});
+  /// @brief Add handler executed by the pool of threads instead of the io thread
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler,
+      std::shared_ptr<thread::PoolThread> pool, const RouteOptions& options = {});
+  /// @brief Add handler consuming the request body by chunks as it arrives
+  void AddStreamRequestHandler(const std::string_view uri, boost::beast::http::verb method, StreamRequestHandler handler,
+      const RouteOptions& options = {});
+  /// @brief Add handler writing the response body by chunks (see ResponseWriter)
+  void AddStreamResponseHandler(const std::string_view uri, boost::beast::http::verb method, StreamResponseHandler handler,
+      const RouteOptions& options = {});
+  /// @brief Add constant response of the route, health check etc
+  /// @param uri - route
+  /// @param method - method of the request
+  /// @param response - template of the response, may be shared by the routes
+  void AddResponse(const std::string_view uri, boost::beast::http::verb method, ResponseTemplatePtr response);
+  /// @brief Add files of the directory, GET and HEAD '/static/style.css' etc
+  /// @param uri - prefix of the route, '/static' etc
+  /// @param root - directory of the files
+  /// @param options - options of the static files
+  void AddStaticFiles(const std::string_view uri, const filesystem::path& root, const StaticFilesOptions& options = {});
+  /// @brief Add WebSocket route, the GET request with the upgrade opens the connection
+  /// @param uri - route
+  /// @param handler - callbacks of the connection
+  /// @param options - options of the connections
+  void AddWebSocketHandler(const std::string_view uri, WebSocketHandler handler, const WebSocketOptions& options = {});
+  /// @brief Add route of the server-sent events (GET), the session is kept open while the stream is open
+  /// @param uri - route
+  /// @param handler - receives the opened stream, the stream may be used from any thread
+  /// @param options - options of the streams
+  void AddEventStreamHandler(const std::string_view uri, EventStreamHandler handler, const EventStreamOptions& options = {});
 private:
   class Impl;
   std::unique_ptr<Impl> impl_;
@@ -0,0 +1,152 @@
+//! @file metrics.h
+//! @brief The declare metrics of the routes of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// boost
+#include <boost/beast/http/verb.hpp>
+
+// this
+#include <cmntype/http/admission.h>
+
+namespace common
+{
+namespace http
+{
+/// @class Histogram
+/// @brief The log-linear histogram (HDR-style): each power of two is split into 8 buckets,
+/// so the relative error of the quantile is less than 12.5% in the whole range
+class Histogram final
+{
+public:
+  static constexpr std::size_t subBits = 3;
+  static constexpr std::size_t subCount = std::size_t{1} << subBits;
+  /// @brief values up to 2^36 (about 19 hours in microseconds), the larger values fall into the last bucket
+  static constexpr std::size_t maxBits = 36;
+  static constexpr std::size_t size = (maxBits - subBits + 1) * subCount;
+
+  /// @brief Index of the bucket of the value
+  static std::size_t Index(std::uint64_t value) noexcept;
+  /// @brief Upper bound (exclusive) of the values of the bucket
+  static std::uint64_t Upper(std::size_t index) noexcept;
+
+  void Add(std::size_t index, std::uint64_t count) noexcept;
+  /// @brief Add the counts of the other histogram
+  void Merge(const Histogram& other) noexcept;
+  std::uint64_t Count() const noexcept { return count_; }
+  /// @brief Value of the quantile (the middle of its bucket)
+  /// @param q - quantile, 0.99 etc
+  std::uint64_t Quantile(double q) const noexcept;
+
+private:
+  std::array<std::uint64_t, size> counts_{};
+  std::uint64_t count_{0};
+};
+
+/// @class RouteMetrics
+/// @brief Counts, bytes and latency of the requests of the route.
+///
+/// The counters are relaxed atomics spread over the shards, each thread writes its own shard,
+/// so the recording doesn't share the cache lines between the io threads. The shards are merged on read.
+class RouteMetrics final
+{
+public:
+  /// @brief Merged metrics of the route
+  struct Snapshot
+  {
+    /// @brief latency in microseconds
+    Histogram latency;
+    std::chrono::microseconds sum{0};
+    std::uint64_t bytesIn{0};
+    std::uint64_t bytesOut{0};
+    /// @brief count of the responses by the status
+    std::map<unsigned, std::uint64_t> statuses;
+    /// @brief count of the responses of the statuses beyond the slots of the shard, by the class (1xx - 5xx)
+    std::array<std::uint64_t, 5> classes{};
+  };
+
+public:
+  RouteMetrics(std::string route, std::string method);
+  RouteMetrics(const RouteMetrics&) = delete;
+  RouteMetrics& operator=(const RouteMetrics&) = delete;
+  /// @brief Record the completed request
+  /// @param status - status of the response
+  /// @param latency - time from the reading of the header to the writing of the response
+  /// @param bytesIn - size of the request
+  /// @param bytesOut - size of the response
+  void Record(unsigned status, std::chrono::steady_clock::duration latency, std::uint64_t bytesIn,
+      std::uint64_t bytesOut) noexcept;
+  Snapshot Get() const;
+  const std::string& Route() const noexcept { return route_; }
+  const std::string& Method() const noexcept { return method_; }
+
+private:
+  static constexpr std::size_t shardCount_ = 8;
+  /// @brief a route responds with a few statuses, the slots are claimed by the statuses as they are seen
+  static constexpr std::size_t statusSlots_ = 16;
+  static constexpr unsigned minStatus_ = 100;
+  static constexpr unsigned maxStatus_ = 600;
+
+  struct StatusCount
+  {
+    /// @brief 0 - the slot is free
+    std::atomic<unsigned> status{0};
+    std::atomic<std::uint64_t> count{0};
+  };
+
+  struct alignas(64) Shard
+  {
+    std::array<std::atomic<std::uint64_t>, Histogram::size> latency{};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> bytesIn{0};
+    std::atomic<std::uint64_t> bytesOut{0};
+    std::array<StatusCount, statusSlots_> statuses{};
+    /// @brief the statuses beyond the slots are counted by the class
+    std::array<std::atomic<std::uint64_t>, (maxStatus_ - minStatus_) / 100> classes{};
+  };
+
+  const std::string route_;
+  const std::string method_;
+  std::array<Shard, shardCount_> shards_;
+};
+
+/// @class Metrics
+/// @brief The registry of the metrics of the routes
+class Metrics final
+{
+public:
+  Metrics();
+  Metrics(const Metrics&) = delete;
+  Metrics& operator=(const Metrics&) = delete;
+  /// @brief Metrics of the route, the same route and method share the metrics
+  /// @param route - route, '/geo/{id}' etc
+  /// @param method - method of the request
+  std::shared_ptr<RouteMetrics> Route(std::string_view route, boost::beast::http::verb method);
+  /// @brief Metrics of the requests without the route (404, 405 and the rejected requests)
+  RouteMetrics& Unmatched() noexcept { return *unmatched_; }
+  /// @brief Metrics in the text format of Prometheus
+  /// @param stats - current counts of the server
+  std::string Format(const ServerStats& stats) const;
+
+private:
+  mutable std::mutex m_;
+  std::vector<std::shared_ptr<RouteMetrics>> routes_;
+  std::shared_ptr<RouteMetrics> unmatched_;
+};
+}  // namespace http
+}  // namespace common
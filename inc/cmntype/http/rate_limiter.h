@@ -0,0 +1,85 @@
+//! @file rate_limiter.h
+//! @brief The declare rate limiter of the clients of the route
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// boost
+#include <boost/asio/ip/address.hpp>
+
+// this
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class RateLimiter
+/// @brief The token buckets of the clients of the route.
+///
+/// The bucket is kept as the theoretical arrival time of the next request (GCRA), so it is one atomic
+/// updated by CAS without the locks. The table has the fixed size: the client is hashed to the shard of
+/// four slots (one cache line). The client whose bucket is full again is forgotten without the loss,
+/// so its slot is reused first; if the shard is busy, the client closest to the full bucket is evicted.
+class RateLimiter final
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+public:
+  explicit RateLimiter(const RateLimitOptions& options);
+  RateLimiter(const RateLimiter&) = delete;
+  RateLimiter& operator=(const RateLimiter&) = delete;
+  /// @brief Key of the remote address
+  std::uint64_t Key(const boost::asio::ip::address& address) const noexcept;
+  /// @brief Key of the value of the configured header, 0 if the header isn't configured or the request hasn't it
+  std::uint64_t Key(const HttpRequestHeader& header) const;
+  /// @brief Take the token of the client
+  /// @return zero if the request is admitted, otherwise the time until the next token
+  Clock::duration Acquire(std::uint64_t key, Clock::time_point now) noexcept;
+  /// @brief Take the tokens of the address and of the value of the header, so the client changing
+  /// the value of the header is still limited by its address
+  /// @return zero if the request is admitted, otherwise the time until the next token
+  Clock::duration Acquire(const HttpRequestHeader& header, const boost::asio::ip::address& address, Clock::time_point now);
+  /// @brief Count of the tracked clients
+  std::size_t Size() const noexcept;
+  /// @brief Count of the rejected requests
+  std::uint64_t Rejected() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr std::size_t slotCount_{4};
+
+  struct Slot
+  {
+    /// @brief hash of the client, 0 - free slot
+    std::atomic<std::uint64_t> key{0};
+    /// @brief theoretical arrival time of the next request, the bucket is full if it isn't later than now
+    std::atomic<Clock::rep> tat{0};
+  };
+
+  struct alignas(64) Shard
+  {
+    std::array<Slot, slotCount_> slots;
+  };
+
+  Clock::duration Take(Slot& slot, Clock::rep now) noexcept;
+
+private:
+  /// @brief interval of the token and the capacity of the bucket
+  const Clock::rep interval_;
+  const Clock::rep tolerance_;
+  const std::string header_;
+  std::vector<Shard> shards_;
+  std::atomic<std::uint64_t> rejected_{0};
+};
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,48 @@
+//! @file responder.h
+//! @brief The declare completion of the asynchronous request handler
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <memory>
+
+// this
+#include <cmntype/http/shared_body.h>
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class Responder
+/// @brief Completion of the asynchronous request handler.
+///
+/// The responder may be copied and called from any thread, the response is written
+/// on the strand of the session. Only the first response is sent; if all copies of the responder
+/// are destroyed without response, the session replies 'internal server error'.
+class Responder final
+{
+public:
+  /// @brief Receiver of the response (session)
+  class Sink
+  {
+  public:
+    virtual ~Sink() = default;
+    virtual void Send(HttpResponse&& response) = 0;
+    virtual void Send(SharedResponse&& response) = 0;
+  };
+
+public:
+  explicit Responder(std::shared_ptr<Sink> sink);
+  /// @brief Send the response
+  void operator()(HttpResponse&& response) const;
+  /// @brief Send the response with the body in the external buffer, the body isn't copied, compressed and cached
+  void operator()(SharedResponse&& response) const;
+
+private:
+  std::shared_ptr<Sink> sink_;
+};
+}  // namespace http
+}  // namespace common
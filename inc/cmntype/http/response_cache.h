@@ -0,0 +1,78 @@
+//! @file response_cache.h
+//! @brief The declare cache of the responses of the route
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// this
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class ResponseCache
+/// @brief The cache of the responses of the route.
+///
+/// The key is the method, the target and the selected headers of the request. The entries expire
+/// after TTL and the least recently used entries are evicted when the total size of the bodies exceeds
+/// the limit. The cache is split into shards with own locks, so the threads rarely contend.
+class ResponseCache final
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using ResponsePtr = std::shared_ptr<const HttpResponse>;
+
+public:
+  explicit ResponseCache(const CacheOptions& options);
+  ResponseCache(const ResponseCache&) = delete;
+  ResponseCache& operator=(const ResponseCache&) = delete;
+  /// @brief Key of the request
+  std::string Key(const HttpRequest& request) const;
+  /// @brief Find the response, nullptr if it isn't cached or expired
+  ResponsePtr Find(const std::string& key);
+  /// @brief Store the response, the 'ETag' is generated by the digest of the body if the response hasn't it.
+  /// Only the successful responses without 'Set-Cookie' and 'Cache-Control: no-store' or 'private' are stored.
+  /// @return the response is stored
+  bool Store(const std::string& key, HttpResponse& response);
+  /// @brief Count of the cached responses
+  std::size_t Size() const;
+
+private:
+  static constexpr std::size_t shardCount_{8};
+
+  struct Entry
+  {
+    ResponsePtr response;
+    Clock::time_point expires;
+    std::list<std::string>::iterator lru;
+  };
+
+  struct Shard
+  {
+    mutable std::mutex m;
+    std::unordered_map<std::string, Entry> entries;
+    std::list<std::string> lru;
+    std::size_t size{0};
+  };
+
+  Shard& GetShard(const std::string& key);
+  static void Erase(Shard& shard, std::unordered_map<std::string, Entry>::iterator it);
+
+private:
+  CacheOptions options_;
+  std::array<Shard, shardCount_> shards_;
+};
+}  // namespace http
+}  // namespace common
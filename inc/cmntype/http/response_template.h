@@ -0,0 +1,77 @@
+//! @file response_template.h
+//! @brief The declare template of the constant response
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <array>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// boost
+#include <boost/asio/buffer.hpp>
+
+// this
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class ResponseTemplate
+/// @brief The constant response built once and sent many times.
+///
+/// The header is serialized for each version (1.0, 1.1) and keep-alive of the request,
+/// the session writes the prepared header and the body without the copy and the formatting.
+/// The template is immutable, so it is shared by the routes and the threads.
+class ResponseTemplate final
+{
+public:
+  /// @brief Template of the response like MakeResponse
+  /// @param status - status of response
+  /// @param contentType - type content, 'application/json' etc
+  /// @param encoding - encoding data
+  /// @param data - content response
+  ResponseTemplate(boost::beast::http::status status, std::string_view contentType, std::string_view encoding,
+      std::string_view data);
+  /// @brief Template of the response with the own headers, the version and the keep-alive are replaced by the request
+  explicit ResponseTemplate(HttpResponse response);
+  ResponseTemplate(const ResponseTemplate&) = delete;
+  ResponseTemplate& operator=(const ResponseTemplate&) = delete;
+
+  /// @brief Serialized header (the status line and the fields)
+  /// @param version - version of the request, 10 or 11
+  /// @param keepAlive - the connection is kept after the response
+  boost::asio::const_buffer Header(unsigned version, bool keepAlive) const noexcept;
+  boost::asio::const_buffer Body() const noexcept
+  {
+    return boost::asio::buffer(response_.body());
+  }
+  unsigned Status() const noexcept
+  {
+    return response_.result_int();
+  }
+  /// @brief Copy of the response for the request
+  HttpResponse Make(const HttpRequest& request) const;
+
+private:
+  static std::size_t Index(unsigned version, bool keepAlive) noexcept
+  {
+    return (version >= 11 ? 2 : 0) + (keepAlive ? 1 : 0);
+  }
+
+private:
+  HttpResponse response_;
+  std::array<std::string, 4> headers_;
+};
+
+using ResponseTemplatePtr = std::shared_ptr<const ResponseTemplate>;
+
+/// @brief Make the shared template of the response
+ResponseTemplatePtr MakeResponseTemplate(boost::beast::http::status status, std::string_view contentType,
+    std::string_view encoding, std::string_view data);
+}  // namespace http
+}  // namespace common
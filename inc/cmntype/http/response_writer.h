@@ -0,0 +1,58 @@
+//! @file response_writer.h
+//! @brief The declare writer of the streamed (chunked) response
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <functional>
+#include <memory>
+#include <string>
+
+// this
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class ResponseWriter
+/// @brief Writer of the response body by chunks (chunked transfer encoding).
+///
+/// The writer may be copied and called from any thread, the data is written on the strand
+/// of the session. The handler of the chunk is called on the io thread after the chunk is written
+/// to the socket, the producer waits for it before the next chunk to keep the memory constant.
+/// If all copies of the writer are destroyed before End(), the response is aborted
+/// ('internal server error' if the header isn't sent yet, otherwise the connection is closed).
+class ResponseWriter final
+{
+public:
+  using WriteHandler = std::function<void(boost::beast::error_code)>;
+
+  /// @brief Receiver of the response (session)
+  class Sink
+  {
+  public:
+    virtual ~Sink() = default;
+    virtual void Begin(HttpResponseHeader&& header) = 0;
+    virtual void Write(std::string&& chunk, WriteHandler&& handler) = 0;
+    virtual void End() = 0;
+  };
+
+public:
+  explicit ResponseWriter(std::shared_ptr<Sink> sink);
+  /// @brief Send the header, the 'Content-Length' isn't used
+  void Begin(HttpResponseHeader&& header) const;
+  /// @brief Send the chunk of the body
+  /// @param chunk - data of the chunk, the empty chunk is ignored
+  /// @param handler - called when the chunk is written or the write is failed
+  void Write(std::string chunk, WriteHandler handler = {}) const;
+  /// @brief Complete the body
+  void End() const;
+
+private:
+  std::shared_ptr<Sink> sink_;
+};
+}  // namespace http
+}  // namespace common
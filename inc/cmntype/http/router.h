@@ -0,0 +1,100 @@
+//! @file router.h
+//! @brief The declare radix tree router of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// boost
+#include <boost/beast/http/verb.hpp>
+
+// this
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class Router
+/// @brief The compiled radix tree of the routes.
+///
+/// The route is a path with the optional parameters and the prefix suffix:
+///  - '/geo/search' - static route;
+///  - '/geo/{id}' - the segment is matched as the parameter 'id';
+///  - '/static/*' - prefix route, the rest of the path is the parameter '*'.
+/// The target is matched as string_view without allocations, the query string is ignored.
+/// Static segments have priority over the parameters, the parameters have priority over the prefix routes.
+/// The priority applies to the routes of the method: '/geo/list' of GET doesn't hide '/geo/{id}' of POST.
+class Router final
+{
+public:
+  /// @brief Result of the search
+  struct Match
+  {
+    /// @brief context of the route, nullptr if the route isn't found
+    const Context* context{nullptr};
+    /// @brief path is found, but the method isn't registered
+    bool methodNotAllowed{false};
+    /// @brief values of the parameters, refer to the target of the request
+    RouteParams params;
+  };
+
+public:
+  Router();
+  /// @brief Add or replace the route
+  /// @param uri - route, '/geo/{id}' etc
+  /// @param context - context of the route
+  void Add(std::string_view uri, Context context);
+  /// @brief Find the route for target
+  /// @param target - target of the request, '/geo/10?format=json' etc
+  /// @param method - method of the request
+  /// @return result of the search
+  Match Find(std::string_view target, boost::beast::http::verb method) const;
+  /// @brief Count of the routes
+  std::size_t Size() const noexcept;
+
+private:
+  using Index = std::uint32_t;
+  using Methods = std::array<std::uint16_t, static_cast<std::size_t>(boost::beast::http::verb::unlink) + 1>;
+
+  static constexpr Index npos = static_cast<Index>(-1);
+
+  struct Node
+  {
+    /// @brief label of the static node
+    std::string prefix;
+    /// @brief name of the parameter node
+    std::string name;
+    /// @brief first characters of the static children
+    std::string indices;
+    std::vector<Index> children;
+    Index param{npos};
+    /// @brief routes of the node, 0 - not found, otherwise index of context + 1
+    Methods methods{};
+    /// @brief prefix routes of the node
+    Methods prefixMethods{};
+    bool endpoint{false};
+    bool prefixEndpoint{false};
+  };
+
+  Index InsertStatic(Index index, std::string_view label);
+  Index InsertParam(Index index, std::string_view name);
+  /// @brief Find the context of the method, the other branches are tried if the path has no such method
+  /// @param pathFound - the path is matched by a route of the other method
+  const Context* MatchNode(Index index, std::string_view path, std::size_t verb, RouteParams& params, bool& pathFound) const;
+  const Context* Get(const Methods& methods, std::size_t verb) const;
+
+private:
+  std::vector<Node> nodes_;
+  std::vector<Context> contexts_;
+};
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,68 @@
+//! @file router_registry.h
+//! @brief The declare registry of the immutable routers
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+
+// this
+#include <cmntype/http/router.h>
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class RouterRegistry
+/// @brief Holds the current immutable router shared between all sessions.
+///
+/// The router is never changed after publication: adding a route copies the current router,
+/// changes the copy and publishes it (copy on write). The readers take the snapshot
+/// and reload it only when the version of the registry is changed, so they never lock.
+class RouterRegistry final
+{
+public:
+  using RouterPtr = std::shared_ptr<const Router>;
+
+  /// @class Snapshot
+  /// @brief The cached router of the reader (session), isn't thread safe
+  class Snapshot final
+  {
+  public:
+    explicit Snapshot(std::shared_ptr<const RouterRegistry> registry);
+    /// @brief Get actual router
+    const Router& Get();
+    /// @brief Get actual router, the pointer keeps it alive after the next reload
+    const RouterPtr& Pin();
+
+  private:
+    std::shared_ptr<const RouterRegistry> registry_;
+    RouterPtr router_;
+    std::uint64_t version_;
+  };
+
+public:
+  RouterRegistry();
+  RouterRegistry(const RouterRegistry&) = delete;
+  RouterRegistry& operator=(const RouterRegistry&) = delete;
+  /// @brief Add or replace the route and publish the new router
+  void Add(std::string_view uri, Context context);
+  /// @brief Get current router
+  RouterPtr Get() const;
+  /// @brief Version of the current router
+  std::uint64_t Version() const noexcept;
+
+private:
+  std::mutex m_;
+  RouterPtr router_;
+  std::atomic<std::uint64_t> version_{0};
+};
+}  // namespace http
+}  // namespace common
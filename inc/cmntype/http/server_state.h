@@ -0,0 +1,56 @@
+//! @file server_state.h
+//! @brief The declare state of the http server shared by the listeners and the sessions
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <atomic>
+#include <memory>
+
+// this
+#include <cmntype/http/admission.h>
+#include <cmntype/http/compression.h>
+#include <cmntype/http/config.h>
+#include <cmntype/http/connections.h>
+#include <cmntype/http/metrics.h>
+#include <cmntype/http/response_template.h>
+#include <cmntype/http/router_registry.h>
+#include <cmntype/http/tls.h>
+
+namespace common
+{
+namespace http
+{
+/// @struct ServerState
+/// @brief The state of the http server shared by the listeners and the sessions
+struct ServerState
+{
+  explicit ServerState(const Configuration& configuration)
+    : config{configuration}
+    , compressor{configuration.compression}
+    , admission{configuration.limits}
+    , tls{MakeTlsContext(configuration.tls)}
+  {
+  }
+
+  const Configuration config;
+  const std::shared_ptr<RouterRegistry> registry{std::make_shared<RouterRegistry>()};
+  const Compressor compressor;
+  Admission admission;
+  /// @brief open connections, they are closed by the stop of the server
+  Connections connections;
+  Metrics metrics;
+  /// @brief responses of the requests without the route
+  const ResponseTemplatePtr notFound{MakeResponseTemplate(boost::beast::http::status::not_found, "application/json",
+      "UTF-8", "not found")};
+  const ResponseTemplatePtr notAllowed{MakeResponseTemplate(boost::beast::http::status::method_not_allowed,
+      "application/json", "UTF-8", "not allowed")};
+  /// @brief context of TLS shared by the connections (the cache of the sessions), nullptr - plain HTTP
+  const std::unique_ptr<boost::asio::ssl::context> tls;
+  /// @brief the server is stopping, the sessions close the connections after the current requests
+  std::atomic<bool> draining{false};
+};
+}  // namespace http
+}  // namespace common
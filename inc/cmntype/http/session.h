@@ -5,19 +5,68 @@
 //! @copyright (c) Bobrov Alexey
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include <boost/beast.hpp>
 #include <boost/asio.hpp>
+#include <boost/circular_buffer.hpp>
 
+#include <cmntype/http/coalescer.h>
+#include <cmntype/http/handler_allocator.h>
+#include <cmntype/http/server_state.h>
+#include <cmntype/http/session_stream.h>
+#include <cmntype/http/timer_wheel.h>
 #include <cmntype/http/types.h>
+#include <cmntype/http/rate_limiter.h>
+#include <cmntype/http/responder.h>
+#include <cmntype/http/response_cache.h>
+#include <cmntype/http/response_template.h>
+#include <cmntype/http/response_writer.h>
+#include <cmntype/http/static_files.h>
 
 namespace common
 {
 namespace http
 {
-class Session : public std::enable_shared_from_this<Session>
+class Session : public std::enable_shared_from_this<Session>, public TimerWheel::Client, public Connections::Connection
 {
+  /// @brief Type-erased response waiting for the write, is allocated from the recycling pool
+  class Work : public Recycled
+  {
+  public:
+    virtual ~Work() = default;
+    virtual void operator()() = 0;
+  };
+
+  /// @brief The pipelined request and its response, the responses are written in order of the requests
+  struct Slot
+  {
+    explicit Slot(HttpRequest&& req)
+      : request{std::move(req)}
+    {
+    }
+
+    HttpRequest request;
+    /// @brief the router of the match, the context of the match refers to it
+    RouterRegistry::RouterPtr router;
+    Router::Match match;
+    /// @brief key of the response cache of the route, the response is stored when it is sent
+    std::string cacheKey;
+    /// @brief the request is in flight (or the stream is open) until the response is written
+    Admission::Ticket ticket;
+    /// @brief time of the reading of the header
+    std::chrono::steady_clock::time_point start;
+    /// @brief size of the request
+    std::uint64_t bytesIn{0};
+    /// @brief status of the response
+    unsigned status{0};
+    std::unique_ptr<Work> response;
+  };
+
   class SendLambda
   {
   public:
@@ -27,48 +76,215 @@ class Session : public std::enable_shared_from_this<Session>
     }
 
     template <bool isRequest, class Body, class Fields>
-    void operator()(boost::beast::http::message<isRequest, Body, Fields>&& msg) const
+    void operator()(Slot& slot, boost::beast::http::message<isRequest, Body, Fields>&& msg) const
     {
-      auto sp = std::make_shared<boost::beast::http::message<isRequest, Body, Fields>>(std::move(msg));
+      Write(slot, std::move(msg));
+    }
+
+    /// @brief Send the response, the body is compressed if the client accepts it
+    void operator()(Slot& slot, HttpResponse&& response) const;
+    /// @brief Send the response with the shared body, the body is compressed if the client accepts it
+    void operator()(Slot& slot, SharedResponse&& response) const;
+    void operator()(Slot& slot, FileResponse&& response) const;
+    /// @brief Send the prepared header and the body of the template without the copy
+    void operator()(Slot& slot, ResponseTemplatePtr&& response) const;
 
-      self_.res_ = sp;
+  private:
+    template <bool isRequest, class Body, class Fields>
+    void Write(Slot& slot, boost::beast::http::message<isRequest, Body, Fields>&& msg) const
+    {
+      class Response final : public Work
+      {
+      public:
+        Response(Session& self, boost::beast::http::message<isRequest, Body, Fields>&& msg)
+          : self_{self}
+          , msg_{std::move(msg)}
+        {
+        }
 
-      boost::beast::http::async_write(self_.stream_, *sp, boost::beast::bind_front_handler(&Session::HandleWrite,
-            self_.shared_from_this(), sp->need_eof()));
+        void operator()() override
+        {
+          boost::beast::http::async_write(self_.stream_, msg_, self_.Bind(&Session::HandleWrite, msg_.need_eof()));
+        }
 
+      private:
+        Session& self_;
+        boost::beast::http::message<isRequest, Body, Fields> msg_;
+      };
+
+      if constexpr (!isRequest)
+      {
+        slot.status = msg.result_int();
+        if (self_.IsClosing(slot))
+        {
+          msg.keep_alive(false);
+        }
+      }
+      slot.response = std::make_unique<Response>(self_, std::move(msg));
+
+      self_.DoWrite();
     }
 
   private:
     Session& self_;
   };
 
+  /// @brief Response with the body sent from the file by sendfile(), by pread() and the write under TLS
+  class FileWork;
+
+  /// @brief Response written from the template
+  class TemplateWork;
+
+  class Reply final : public Responder::Sink
+  {
+  public:
+    Reply(std::shared_ptr<Session> self, Slot& slot);
+    ~Reply() override;
+    void Send(HttpResponse&& response) override;
+    void Send(SharedResponse&& response) override;
+  private:
+    template <class Response>
+    void Post(Response&& response);
+  private:
+    std::shared_ptr<Session> self_;
+    Slot& slot_;
+    std::atomic<bool> sent_{false};
+  };
+
+  /// @brief State of the chunked response, is changed only on the strand of the session
+  class Chunked;
+
+  class Writer final : public ResponseWriter::Sink
+  {
+  public:
+    Writer(std::shared_ptr<Session> self, Slot& slot);
+    ~Writer() override;
+    void Begin(HttpResponseHeader&& header) override;
+    void Write(std::string&& chunk, ResponseWriter::WriteHandler&& handler) override;
+    void End() override;
+  private:
+    std::shared_ptr<Session> self_;
+    std::shared_ptr<Chunked> chunked_;
+    std::atomic<bool> ended_{false};
+  };
+
+  /// @brief Hand over the connection to the WebSocket session after the previous responses
+  class UpgradeWork;
+
   class Dispatcher
   {
   public:
     explicit Dispatcher(Session& self);
-    void operator()(const HttpRequest& request) const;
+    void operator()(Slot& slot) const;
   private:
     Session& self_;
   };
 
 public:
-  Session(boost::asio::ip::tcp::socket&& socket, const Handlers& handlers);
+  Session(ConnectionSocket&& socket, std::shared_ptr<ServerState> state, Admission::Ticket connection,
+      TimerWheel& wheel);
   void Run();
+  void DoHandshake();
   void DoRead();
+  void DoWrite();
   void DoClose();
 
   void HandleWrite(bool close, boost::beast::error_code ec, std::size_t bytesTransferred);
   void HandleClose();
+  void Abort() noexcept override;
+  /// @brief End the event stream of the connection by the drain of the server
+  void Shutdown() override;
+  void HandleHandshake(boost::beast::error_code ec);
+  /// @brief The first bytes of the next request of the keep-alive connection are read
+  void HandleReadIdle(boost::beast::error_code ec, std::size_t bytesTransferred);
+  void HandleReadHeader(boost::beast::error_code ec, std::size_t bytesTransferred);
   void HandleRead(boost::beast::error_code ec, std::size_t bytesTransferred);
+  void HandleReadChunk(boost::beast::error_code ec, std::size_t bytesTransferred);
 private:
-  boost::beast::tcp_stream stream_;
+  void OnExpire(TimerWheel::Tick deadline) override;
+  /// @brief Arm the timeout of the current phase: write, read or nothing (the handler is working)
+  void UpdateTimer();
+  bool CanRead() const noexcept;
+  void DoReadHeader();
+  void DoReadChunk();
+  Slot& Push(HttpRequest&& request);
+  bool FromCache(Slot& slot);
+  /// @brief Start or join the flight of the handler of the route
+  /// @return false if the request isn't coalesced
+  bool Coalesce(Slot& slot);
+  void Dispatch(HttpRequest&& request);
+  /// @brief The token of the client is taken from the rate limiter of the route
+  /// @return zero if the request is admitted, otherwise the time until the next token
+  RateLimiter::Clock::duration Limit(const HttpRequestHeader& header);
+  void Reject(HttpRequest&& request, boost::beast::http::status status, std::chrono::seconds retryAfter = {});
+  void Upgrade(HttpRequest&& request);
+  /// @brief Check the drain of the server, the reading is stopped and the last response closes the connection
+  /// @return true if the response of the slot must close the connection
+  bool IsClosing(const Slot& slot) noexcept;
+  /// @brief Record the metrics of the written response
+  void Record(const Slot& slot, std::size_t bytesOut) const noexcept;
+  /// @brief Completion handler of the member function, the state of the operation is allocated from the recycling pool
+  template <class Function, class... Args>
+  auto Bind(Function function, Args&&... args)
+  {
+    return MakeRecyclingHandler(boost::beast::bind_front_handler(function, shared_from_this(), std::forward<Args>(args)...));
+  }
+  /// @brief Object shared by the handlers, is allocated from the recycling pool
+  template <class T, class... Args>
+  static std::shared_ptr<T> MakeShared(Args&&... args)
+  {
+    return std::allocate_shared<T>(HandlerAllocator<T>{}, std::forward<Args>(args)...);
+  }
+private:
+  /// @brief size of the chunk of the streamed body
+  static constexpr std::size_t chunkSize_{64 * 1024};
+  /// @brief size of the read waiting for the next request of the keep-alive connection
+  static constexpr std::size_t idleReadSize_{4 * 1024};
+
+  /// @brief the state outlives the tickets of the session
+  std::shared_ptr<ServerState> state_;
+  Admission::Ticket connection_;
+  SessionStream stream_;
+  /// @brief the strand of the connection, the stream is moved out by the upgrade
+  ConnectionExecutor executor_;
   boost::beast::flat_buffer buffer_;
-  boost::beast::http::request<boost::beast::http::string_body> req_;
-  std::shared_ptr<void> res_;
-  Handlers handlers_;
+  std::optional<boost::beast::http::request_parser<boost::beast::http::empty_body>> header_;
+  std::optional<boost::beast::http::request_parser<boost::beast::http::string_body>> parser_;
+  std::optional<boost::beast::http::request_parser<boost::beast::http::buffer_body>> streamParser_;
+  std::unique_ptr<BodyConsumer> consumer_;
+  std::vector<char> chunk_;
+  /// @brief the router is pinned until the match is moved to the slot
+  RouterRegistry::RouterPtr matchRouter_;
+  Router::Match match_;
+  /// @brief the target the parameters of the match refer to, they are rebased onto the target of the slot
+  const char* matchTarget_{nullptr};
+  Admission::Ticket ticket_;
+  /// @brief address of the client, is resolved by the first rate limited request
+  std::optional<boost::asio::ip::address> remote_;
+  /// @brief time and size of the current request
+  std::chrono::steady_clock::time_point start_;
+  std::uint64_t bytesIn_{0};
+  /// @brief the slots are constructed in the storage allocated once for the pipeline limit
+  boost::circular_buffer<Slot, HandlerAllocator<Slot>> queue_;
+  std::size_t pipelineLimit_;
+  std::uint64_t bodyLimit_;
+  TimerWheel& wheel_;
+  const Configuration::Timeouts& timeouts_;
+  /// @brief timeout of the current read
+  std::chrono::milliseconds readTimeout_;
+  /// @brief count of the read requests
+  std::size_t requests_{0};
+  bool reading_{false};
+  bool writing_{false};
+  bool readClosed_{false};
+  /// @brief the connection is handed over to the WebSocket session
+  bool upgraded_{false};
+  /// @brief the long-lived stream of the connection, it is ended by the drain
+  std::weak_ptr<Chunked> events_;
+  RouterRegistry::Snapshot router_;
   SendLambda lambda_;
   Dispatcher dispatcher_;
-  
+
 };
 }
 }
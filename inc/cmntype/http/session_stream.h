@@ -0,0 +1,120 @@
+//! @file session_stream.h
+//! @brief The declare stream of the http session (TCP or TLS)
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <optional>
+#include <utility>
+
+// boost
+#include <boost/asio.hpp>
+#include <boost/asio/ssl.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket/ssl.hpp>
+#include <boost/beast/websocket/teardown.hpp>
+
+namespace common
+{
+namespace http
+{
+/// @brief Executor of the connection, the strand isn't type-erased, so the copies of the executor
+/// by the operations (the work guards etc) don't allocate
+using ConnectionExecutor = boost::asio::strand<boost::asio::io_context::executor_type>;
+/// @brief Accepted socket of the connection
+using ConnectionSocket = boost::asio::basic_stream_socket<boost::asio::ip::tcp, ConnectionExecutor>;
+/// @brief TCP stream of the connection
+using TcpStream = boost::beast::basic_stream<boost::asio::ip::tcp, ConnectionExecutor>;
+
+/// @class SessionStream
+/// @brief The stream of the session, the operations are forwarded to TLS or to TCP.
+///
+/// The kind of the stream is chosen once per connection, so one session type serves both HTTP and HTTPS
+/// without the virtual calls in the operations. The stream is moved to the WebSocket session by the upgrade.
+class SessionStream
+{
+public:
+  using executor_type = ConnectionExecutor;
+  using TlsStream = boost::beast::ssl_stream<TcpStream>;
+
+public:
+  /// @param socket - accepted socket
+  /// @param context - context of TLS, nullptr - plain TCP
+  SessionStream(ConnectionSocket&& socket, boost::asio::ssl::context* context);
+
+  executor_type get_executor() noexcept
+  {
+    return next_layer().get_executor();
+  }
+
+  bool IsTls() const noexcept
+  {
+    return tls_.has_value();
+  }
+
+  /// @brief TCP layer of the stream (under TLS if it is enabled), is used by boost::beast::get_lowest_layer
+  TcpStream& next_layer() noexcept;
+
+  ConnectionSocket& Socket() noexcept
+  {
+    return next_layer().socket();
+  }
+
+  TlsStream& Tls() noexcept
+  {
+    return *tls_;
+  }
+
+  /// @brief Close the socket, the pending operations are cancelled
+  void Close() noexcept;
+
+  template <class MutableBufferSequence, class ReadHandler>
+  void async_read_some(const MutableBufferSequence& buffers, ReadHandler&& handler)
+  {
+    if (tls_)
+    {
+      tls_->async_read_some(buffers, std::forward<ReadHandler>(handler));
+    }
+    else
+    {
+      tcp_->async_read_some(buffers, std::forward<ReadHandler>(handler));
+    }
+  }
+
+  template <class ConstBufferSequence, class WriteHandler>
+  void async_write_some(const ConstBufferSequence& buffers, WriteHandler&& handler)
+  {
+    if (tls_)
+    {
+      tls_->async_write_some(buffers, std::forward<WriteHandler>(handler));
+    }
+    else
+    {
+      tcp_->async_write_some(buffers, std::forward<WriteHandler>(handler));
+    }
+  }
+
+private:
+  std::optional<TcpStream> tcp_;
+  std::optional<TlsStream> tls_;
+};
+
+/// @brief Close of the WebSocket connection, the TLS connection is shut down before the socket
+template <class TeardownHandler>
+void async_teardown(boost::beast::role_type role, SessionStream& stream, TeardownHandler&& handler)
+{
+  using boost::beast::websocket::async_teardown;
+  if (stream.IsTls())
+  {
+    async_teardown(role, stream.Tls(), std::forward<TeardownHandler>(handler));
+  }
+  else
+  {
+    async_teardown(role, stream.next_layer(), std::forward<TeardownHandler>(handler));
+  }
+}
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,98 @@
+//! @file shared_body.h
+//! @brief The declare body of the message referencing the external buffer
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+// boost
+#include <boost/beast/http.hpp>
+#include <boost/optional.hpp>
+
+namespace common
+{
+namespace http
+{
+/// @struct SharedBody
+/// @brief Body of the message (the Body concept of boost::beast) referencing the external buffer.
+///
+/// The buffer is written to the socket as it is, the owner keeps the buffer alive until the write is completed.
+/// The same buffer may be sent by many responses at once. The body is only written, it isn't read.
+struct SharedBody
+{
+  class value_type
+  {
+  public:
+    value_type() = default;
+    /// @brief Shared string
+    explicit value_type(std::shared_ptr<const std::string> buffer)
+      : data_{buffer ? buffer->data() : nullptr}
+      , size_{buffer ? buffer->size() : 0}
+      , owner_{std::move(buffer)}
+    {
+    }
+    /// @brief Span of the buffer
+    /// @param data - data of the buffer
+    /// @param size - size of the buffer
+    /// @param owner - owner of the buffer, nullptr if the buffer outlives the response (static data etc)
+    value_type(const void* data, std::size_t size, std::shared_ptr<const void> owner = {})
+      : data_{data}
+      , size_{size}
+      , owner_{std::move(owner)}
+    {
+    }
+
+    const void* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    /// @brief Owner of the buffer, nullptr if the buffer outlives the response
+    const std::shared_ptr<const void>& owner() const noexcept { return owner_; }
+
+  private:
+    const void* data_{nullptr};
+    std::size_t size_{0};
+    std::shared_ptr<const void> owner_;
+  };
+
+  static std::uint64_t size(const value_type& body) noexcept
+  {
+    return body.size();
+  }
+
+  class writer
+  {
+  public:
+    using const_buffers_type = boost::asio::const_buffer;
+
+    template <bool isRequest, class Fields>
+    writer(const boost::beast::http::header<isRequest, Fields>&, const value_type& body)
+      : body_{body}
+    {
+    }
+
+    void init(boost::beast::error_code& ec)
+    {
+      ec = {};
+    }
+
+    boost::optional<std::pair<const_buffers_type, bool>> get(boost::beast::error_code& ec)
+    {
+      ec = {};
+      return {{const_buffers_type{body_.data(), body_.size()}, false}};
+    }
+
+  private:
+    const value_type& body_;
+  };
+};
+
+/// @brief Response with the body in the external buffer
+using SharedResponse = boost::beast::http::response<SharedBody>;
+}  // namespace http
+}  // namespace common
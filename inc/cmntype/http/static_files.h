@@ -0,0 +1,70 @@
+//! @file static_files.h
+//! @brief The declare static files route of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <variant>
+
+// this
+#include <cmntype/config.h>
+#include <cmntype/http/file_cache.h>
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @brief Options of the static files route
+struct StaticFilesOptions
+{
+  /// @brief file of the directory request, '/static/' etc
+  std::string index{"index.html"};
+  /// @brief maximum count of the cached open files
+  std::size_t cacheSize{1024};
+  /// @brief interval of the revalidation of the cached file
+  std::chrono::milliseconds revalidate{1000};
+};
+
+/// @brief Response with the body sent from the file (range of the file)
+struct FileResponse
+{
+  boost::beast::http::response<boost::beast::http::empty_body> header;
+  FileCache::FilePtr file;
+  std::uint64_t offset{0};
+  std::uint64_t size{0};
+};
+
+/// @class StaticFiles
+/// @brief The static files of the directory.
+///
+/// Supports 'Range' (single range, 206/416), 'If-None-Match', 'If-Modified-Since' (304)
+/// and 'If-Range'. The body is sent by sendfile() without copying through userspace.
+class StaticFiles final
+{
+public:
+  using Reply = std::variant<HttpResponse, FileResponse>;
+
+public:
+  StaticFiles(const filesystem::path& root, const StaticFilesOptions& options);
+  /// @brief Make response for the request
+  /// @param request - request
+  /// @param path - path of the file relative to the root, the percent-encoded
+  Reply Serve(const HttpRequest& request, std::string_view path) const;
+
+private:
+  std::string root_;
+  StaticFilesOptions options_;
+  mutable FileCache cache_;
+};
+
+/// @brief Get MIME type by extension of the file
+std::string_view MimeType(std::string_view path);
+}  // namespace http
+}  // namespace common
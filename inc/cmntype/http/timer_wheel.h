@@ -0,0 +1,90 @@
+//! @file timer_wheel.h
+//! @brief The declare timer wheel of the sessions timeouts
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// boost
+#include <boost/asio.hpp>
+
+namespace common
+{
+namespace http
+{
+/// @class TimerWheel
+/// @brief The coarse-grained hashed timer wheel.
+///
+/// The wheel has one steady timer, which ticks with the resolution and visits one slot per tick.
+/// Arming the client is the atomic store of the deadline; the client is put into the slot only if
+/// the new deadline is earlier than the scheduled one. When the slot is visited, the clients with
+/// the later deadline are moved to their slots and the expired clients are notified, so the idle
+/// connections are reaped in bulk without the timer per connection.
+class TimerWheel final
+{
+public:
+  using Tick = std::uint64_t;
+  static constexpr Tick never = std::numeric_limits<Tick>::max();
+
+  /// @class Client
+  /// @brief The object with the deadline (session)
+  class Client
+  {
+  public:
+    virtual ~Client() = default;
+
+  protected:
+    /// @brief The deadline is expired, is called on the thread of the wheel
+    /// @param deadline - expired deadline, it is compared with Deadline() on the strand of the client
+    virtual void OnExpire(Tick deadline) = 0;
+    /// @brief Current deadline
+    Tick Deadline() const noexcept { return deadline_.load(std::memory_order_acquire); }
+
+  private:
+    friend class TimerWheel;
+    std::atomic<Tick> deadline_{never};
+    /// @brief tick of the slot, where the client is waiting
+    std::atomic<Tick> scheduled_{never};
+  };
+
+public:
+  /// @param io - context of the ticks, the wheel must be destroyed before the context
+  /// @param resolution - duration of the tick
+  /// @param slots - count of the slots
+  TimerWheel(boost::asio::io_context& io, std::chrono::milliseconds resolution, std::size_t slots = 1024);
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  void Start();
+  void Stop();
+  /// @brief Set the deadline of the client, the previous deadline is replaced
+  void Arm(const std::shared_ptr<Client>& client, std::chrono::milliseconds timeout);
+  /// @brief Reset the deadline of the client
+  static void Disarm(Client& client) noexcept;
+  /// @brief Count of the clients in the slots (with the stale entries)
+  std::size_t Size() const;
+
+private:
+  void Schedule(const std::shared_ptr<Client>& client, Tick tick);
+  void Wait();
+  void OnTick(boost::system::error_code ec);
+
+private:
+  boost::asio::steady_timer timer_;
+  std::chrono::milliseconds resolution_;
+  std::atomic<Tick> now_{0};
+  std::atomic<bool> stop_{true};
+  mutable std::mutex m_;
+  std::vector<std::vector<std::weak_ptr<Client>>> slots_;
+  std::vector<std::weak_ptr<Client>> visited_;
+};
+}  // namespace http
+}  // namespace common
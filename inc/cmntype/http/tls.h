@@ -0,0 +1,28 @@
+//! @file tls.h
+//! @brief The declare TLS context of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <memory>
+
+// boost
+#include <boost/asio/ssl.hpp>
+
+// this
+#include <cmntype/http/config.h>
+
+namespace common
+{
+namespace http
+{
+/// @brief Make the server context of TLS with the cache of the sessions and the tickets.
+/// The context is shared by all listeners, so the resumed session may be handled by any thread
+/// @param config - configuration of TLS
+/// @return context, nullptr if TLS is disabled
+/// @throw common::error::Error if the certificate or the key isn't loaded
+std::unique_ptr<boost::asio::ssl::context> MakeTlsContext(const Configuration::Tls& config);
+}  // namespace http
+}  // namespace common
@@ -6,12 +6,19 @@
 #pragma once
 
 // std
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
-#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 // boost
 #include <boost/beast.hpp>
+#include <boost/container/static_vector.hpp>
 
 namespace common
 {
@@ -30,14 +37,126 @@ using HttpResponse = boost::beast::http::response<boost::beast::http::string_bod
 using HttpRequest = boost::beast::http::request<boost::beast::http::string_body>;
 using HttpResponsePtr = std::shared_ptr<HttpResponse>;
 using HttpRequestPtr = std::shared_ptr<HttpRequest>;
+using HttpRequestHeader = boost::beast::http::request_header<>;
+using HttpResponseHeader = boost::beast::http::response_header<>;
 using RequestHandler = std::function<HttpResponse(const HttpRequest&)>;
+
+/// @brief Maximum count of the parameters in the route
+constexpr std::size_t MaxRouteParams = 8;
+
+/// @brief Parameter of the route, '/geo/{id}' etc
+struct RouteParam
+{
+  std::string_view name;
+  std::string_view value;
+};
+
+using RouteParams = boost::container::static_vector<RouteParam, MaxRouteParams>;
+using RouteRequestHandler = std::function<HttpResponse(const HttpRequest&, const RouteParams&)>;
+
+class Responder;
+/// @brief Asynchronous handler, the request is valid until the response is sent by the responder
+using AsyncRequestHandler = std::function<void(const HttpRequest&, Responder)>;
+
+/// @class BodyConsumer
+/// @brief Consumer of the streamed request body, is called on the io thread
+class BodyConsumer
+{
+public:
+  virtual ~BodyConsumer() = default;
+  /// @brief Next chunk of the body, the chunk is valid only during the call
+  virtual void OnChunk(std::string_view chunk) = 0;
+  /// @brief The body is complete, the response is sent by the responder
+  virtual void OnComplete(const HttpRequestHeader& header, Responder responder) = 0;
+};
+
+/// @brief Streaming handler, creates the consumer of the body after the header is read.
+/// If the handler returns nullptr, the request is rejected with 'bad request'.
+using StreamRequestHandler = std::function<std::unique_ptr<BodyConsumer>(const HttpRequestHeader&)>;
+
+class ResponseWriter;
+/// @brief Streaming handler of the response, the body is written by chunks.
+/// The request is valid until the response is completed by the writer.
+using StreamResponseHandler = std::function<void(const HttpRequest&, ResponseWriter)>;
+
+/// @brief Options of the response cache of the route
+struct CacheOptions
+{
+  /// @brief time to live of the cached response
+  std::chrono::milliseconds ttl{1000};
+  /// @brief maximum total size of the cached bodies
+  std::size_t maxSize{16 * 1024 * 1024};
+  /// @brief headers of the request added to the key (method and target), 'Accept-Language' etc
+  std::vector<std::string> vary;
+};
+
+/// @brief Options of the coalescing of the concurrent identical requests of the route
+struct CoalesceOptions
+{
+  /// @brief headers of the request added to the key (method and target), 'Accept-Language' etc
+  std::vector<std::string> vary;
+};
+
+/// @brief Options of the rate limit of the route, the token bucket of each client
+struct RateLimitOptions
+{
+  /// @brief tokens added per second, the sustained rate of the requests of the client
+  double rate{10.0};
+  /// @brief capacity of the bucket, the requests of the client allowed at once
+  std::size_t burst{20};
+  /// @brief header of the request identifying the client ('X-Api-Key' etc), the requests with the same value
+  /// share the bucket whatever the address is. The remote address is limited first, so the client
+  /// changing the value isn't admitted over the limit of its address
+  std::string header;
+  /// @brief maximum count of the tracked clients, the stale clients are evicted
+  std::size_t clients{64 * 1024};
+};
+
+/// @brief Options of the route
+struct RouteOptions
+{
+  /// @brief Maximum size of the request body, Configuration::bodyLimit by default
+  std::optional<std::uint64_t> bodyLimit;
+  /// @brief The body of the response is the same for the repeated requests,
+  /// the compressed body is cached and reused
+  bool cacheable{false};
+  /// @brief The successful responses of GET and HEAD are cached and served without the handler
+  std::optional<CacheOptions> cache;
+  /// @brief The requests exceeding the rate of the client are rejected with 429 before the handler
+  std::optional<RateLimitOptions> rateLimit;
+  /// @brief The concurrent GET and HEAD with the same key wait for one call of the handler and share its response
+  std::optional<CoalesceOptions> coalesce;
+};
+
+class StaticFiles;
+class ResponseCache;
+class RateLimiter;
+class Coalescer;
+class ResponseTemplate;
+class RouteMetrics;
+struct WebSocketRoute;
+
 struct Context
 {
   boost::beast::http::verb method;
   RequestHandler handler;
+  RouteRequestHandler routeHandler;
+  AsyncRequestHandler asyncHandler;
+  StreamRequestHandler streamHandler;
+  StreamResponseHandler streamResponseHandler;
+  std::shared_ptr<const StaticFiles> files;
+  std::shared_ptr<ResponseCache> cache;
+  std::shared_ptr<RateLimiter> rateLimiter;
+  std::shared_ptr<Coalescer> coalescer;
+  std::shared_ptr<RouteMetrics> metrics;
+  std::shared_ptr<const WebSocketRoute> webSocket;
+  /// @brief constant response of the route
+  std::shared_ptr<const ResponseTemplate> response;
+  /// @brief the streamed response of the route isn't completed by the handler (server-sent events),
+  /// it isn't waited by the drain and is ended by the shutdown of the connection
+  bool longLived{false};
+  RouteOptions options;
 };
 
-using Handlers = std::multimap<std::string, Context>;
-
 }
 }
@@ -0,0 +1,126 @@
+//! @file websocket.h
+//! @brief The declare WebSocket connection and broadcast channel
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// this
+#include <cmntype/http/types.h>
+
+namespace common
+{
+namespace http
+{
+/// @class WebSocket
+/// @brief The opened WebSocket connection.
+///
+/// The handle may be copied and used from any thread, the messages are written in order
+/// on the strand of the connection. The messages over the limit of the send queue are handled
+/// by WebSocketOptions::overflow. After the close the messages are ignored.
+class WebSocket final
+{
+public:
+  /// @brief Message shared by the connections (see WebSocketChannel)
+  using Buffer = std::shared_ptr<const std::string>;
+
+  /// @brief Receiver of the messages (WebSocket session)
+  class Sink
+  {
+  public:
+    virtual ~Sink() = default;
+    virtual void Send(Buffer&& message, bool text) = 0;
+    virtual void Close() = 0;
+    virtual bool IsOpen() const noexcept = 0;
+  };
+
+public:
+  explicit WebSocket(std::shared_ptr<Sink> sink);
+  /// @brief Send the message
+  /// @param message - data of the message
+  /// @param text - type of the message (text or binary)
+  void Send(std::string message, bool text = true) const;
+  /// @brief Send the shared message without the copy
+  void Send(Buffer message, bool text = true) const;
+  /// @brief Close the connection, the queued messages are discarded
+  void Close() const;
+  bool IsOpen() const noexcept;
+
+private:
+  friend class WebSocketChannel;
+  std::shared_ptr<Sink> sink_;
+};
+
+/// @class WebSocketChannel
+/// @brief Broadcast of the messages to the joined connections.
+///
+/// The message is stored once in the shared buffer, the connections write the same buffer.
+/// The channel doesn't own the connections, the closed connections leave the channel on the next publish.
+class WebSocketChannel final
+{
+public:
+  WebSocketChannel() = default;
+  WebSocketChannel(const WebSocketChannel&) = delete;
+  WebSocketChannel& operator=(const WebSocketChannel&) = delete;
+  /// @brief Subscribe the connection to the messages of the channel
+  void Join(const WebSocket& socket);
+  /// @brief Send the message to all connections of the channel
+  /// @return count of the connections
+  std::size_t Publish(std::string message, bool text = true);
+  std::size_t Publish(WebSocket::Buffer message, bool text = true);
+  /// @brief Count of the connections (with the closed ones, which haven't left yet)
+  std::size_t Size() const;
+
+private:
+  mutable std::mutex m_;
+  std::vector<std::weak_ptr<WebSocket::Sink>> sinks_;
+};
+
+/// @brief Options of the WebSocket route
+struct WebSocketOptions
+{
+  /// @brief Behaviour when the send queue of the connection is full (slow client)
+  enum class Overflow
+  {
+    /// @brief the new message is dropped
+    drop,
+    /// @brief the connection is closed
+    close
+  };
+
+  /// @brief maximum count of the messages waiting for the write
+  std::size_t queueLimit{256};
+  Overflow overflow{Overflow::close};
+  /// @brief maximum size of the received message
+  std::uint64_t messageLimit{1024 * 1024};
+};
+
+/// @brief Callbacks of the WebSocket route, are called on the io thread of the connection
+struct WebSocketHandler
+{
+  /// @brief The connection is opened by the upgrade request
+  std::function<void(const HttpRequest& request, const WebSocket& socket)> onOpen;
+  /// @brief The message is received
+  std::function<void(const WebSocket& socket, std::string_view message, bool text)> onMessage;
+  /// @brief The connection is closed by any side or by the error
+  std::function<void(const WebSocket& socket)> onClose;
+};
+
+/// @brief WebSocket route
+struct WebSocketRoute
+{
+  WebSocketHandler handler;
+  WebSocketOptions options;
+};
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,78 @@
+//! @file websocket_session.h
+//! @brief The declare WebSocket session
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+#pragma once
+
+// std
+#include <atomic>
+#include <deque>
+#include <memory>
+
+// boost
+#include <boost/asio.hpp>
+#include <boost/beast.hpp>
+#include <boost/beast/websocket.hpp>
+
+// this
+#include <cmntype/http/server_state.h>
+#include <cmntype/http/session_stream.h>
+#include <cmntype/http/websocket.h>
+
+namespace common
+{
+namespace http
+{
+/// @class WebSocketSession
+/// @brief The connection upgraded by the http session, owns the stream (TCP or TLS) until the close
+class WebSocketSession final : public WebSocket::Sink, public Connections::Connection,
+                               public std::enable_shared_from_this<WebSocketSession>
+{
+  struct Message
+  {
+    WebSocket::Buffer data;
+    bool text;
+  };
+
+public:
+  WebSocketSession(SessionStream&& stream, std::shared_ptr<ServerState> state, Admission::Ticket connection,
+      std::shared_ptr<const WebSocketRoute> route);
+  /// @brief Accept the upgrade request
+  void Run(HttpRequest&& request);
+
+  void Send(WebSocket::Buffer&& message, bool text) override;
+  void Close() override;
+  bool IsOpen() const noexcept override;
+  void Abort() noexcept override;
+  /// @brief Close the connection with 'going away' by the drain of the server
+  void Shutdown() override;
+
+private:
+  void HandleAccept(boost::beast::error_code ec);
+  void DoRead();
+  void HandleRead(boost::beast::error_code ec, std::size_t bytesTransferred);
+  void Push(Message&& message);
+  void DoWrite();
+  void HandleWrite(boost::beast::error_code ec, std::size_t bytesTransferred);
+  void DoClose(boost::beast::websocket::close_code code);
+  void Finish();
+
+private:
+  std::shared_ptr<ServerState> state_;
+  Admission::Ticket connection_;
+  /// @brief the drain waits for the close of the connection
+  Admission::Ticket shutdown_;
+  std::shared_ptr<const WebSocketRoute> route_;
+  boost::beast::websocket::stream<SessionStream> ws_;
+  /// @brief the upgrade request is kept until the handshake is completed
+  HttpRequest request_;
+  boost::beast::flat_buffer buffer_;
+  std::deque<Message> queue_;
+  bool writing_{false};
+  bool closing_{false};
+  std::atomic<bool> open_{false};
+  bool finished_{false};
+};
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,113 @@
+//! @file admission.cpp
+//! @brief The implementation admission control of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// this
+#include <cmntype/http/admission.h>
+
+namespace common
+{
+namespace http
+{
+
+Admission::Ticket::Ticket(std::atomic<std::size_t>* counter) noexcept
+: counter_{counter}
+{
+}
+
+Admission::Ticket::Ticket(Ticket&& other) noexcept
+: counter_{other.counter_}
+{
+  other.counter_ = nullptr;
+}
+
+Admission::Ticket& Admission::Ticket::operator=(Ticket&& other) noexcept
+{
+  if (this != &other)
+  {
+    Reset();
+    counter_ = other.counter_;
+    other.counter_ = nullptr;
+  }
+  return *this;
+}
+
+Admission::Ticket::~Ticket()
+{
+  Reset();
+}
+
+void Admission::Ticket::Reset() noexcept
+{
+  if (counter_)
+  {
+    counter_->fetch_sub(1, std::memory_order_relaxed);
+    counter_ = nullptr;
+  }
+}
+
+Admission::Admission(const Configuration::Limits& limits)
+: limits_{limits}
+{
+}
+
+Admission::Ticket Admission::AdmitConnection() noexcept
+{
+  return Admit(connections_, limits_.connections, rejectedConnections_);
+}
+
+Admission::Ticket Admission::AdmitRequest() noexcept
+{
+  return Admit(requests_, limits_.requests, rejectedRequests_);
+}
+
+Admission::Ticket Admission::AdmitStream() noexcept
+{
+  return Admit(streams_, limits_.streams, rejectedRequests_);
+}
+
+Admission::Ticket Admission::HoldRequest() noexcept
+{
+  requests_.fetch_add(1, std::memory_order_relaxed);
+  return Ticket{&requests_};
+}
+
+bool Admission::IsFull() const noexcept
+{
+  return limits_.connections && connections_.load(std::memory_order_relaxed) >= limits_.connections;
+}
+
+void Admission::Pause() noexcept
+{
+  pausedAccepts_.fetch_add(1, std::memory_order_relaxed);
+}
+
+ServerStats Admission::GetStats() const noexcept
+{
+  ServerStats stats;
+  stats.connections = connections_.load(std::memory_order_relaxed);
+  stats.requests = requests_.load(std::memory_order_relaxed);
+  stats.streams = streams_.load(std::memory_order_relaxed);
+  stats.rejectedConnections = rejectedConnections_.load(std::memory_order_relaxed);
+  stats.rejectedRequests = rejectedRequests_.load(std::memory_order_relaxed);
+  stats.pausedAccepts = pausedAccepts_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+Admission::Ticket Admission::Admit(std::atomic<std::size_t>& counter, std::size_t limit, std::atomic<std::uint64_t>& rejected) noexcept
+{
+  // the counter is exceeded for a moment by the concurrent admission, it is cheaper than CAS loop
+  const auto current = counter.fetch_add(1, std::memory_order_relaxed);
+  if (limit && current >= limit)
+  {
+    counter.fetch_sub(1, std::memory_order_relaxed);
+    rejected.fetch_add(1, std::memory_order_relaxed);
+    return Ticket{};
+  }
+  return Ticket{&counter};
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,158 @@
+//! @file coalescer.cpp
+//! @brief The implementation coalescing of the concurrent identical requests of the route
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <functional>
+#include <vector>
+
+// this
+#include <cmntype/http/coalescer.h>
+#include <cmntype/http/http_response.h>
+#include <cmntype/logger/logger.h>
+
+namespace common
+{
+namespace http
+{
+
+/// @brief The call of the handler shared by the requests of the key
+class Coalescer::Flight final : public Responder::Sink
+{
+public:
+  Flight(std::shared_ptr<Coalescer> owner, Shard& shard, const std::string& key)
+    : owner_{std::move(owner)}
+    , shard_{shard}
+    , key_{key}
+  {
+  }
+
+  ~Flight() override
+  {
+    // the responders of the waiting requests reply 'internal server error'
+    Finish();
+  }
+
+  /// @brief Add the request, is called under the lock of the shard
+  void Add(const HttpRequest& request, Responder&& responder)
+  {
+    waiters_.push_back(Waiter{std::move(responder), request.version(), request.keep_alive()});
+  }
+
+  void Send(HttpResponse&& response) override
+  {
+    auto waiters = Finish();
+    if (waiters.size() < 2)
+    {
+      return Deliver(std::move(waiters), std::move(response));
+    }
+
+    // the body is moved to the shared buffer once, the waiters take the copies of the header
+    auto body = std::make_shared<const std::string>(std::move(response.body()));
+    SharedResponse shared{std::move(response.base())};
+    shared.body() = SharedBody::value_type{std::move(body)};
+    Deliver(std::move(waiters), std::move(shared));
+  }
+
+  void Send(SharedResponse&& response) override
+  {
+    Deliver(Finish(), std::move(response));
+  }
+
+private:
+  struct Waiter
+  {
+    Responder responder;
+    unsigned version;
+    bool keepAlive;
+  };
+
+  /// @brief Remove the flight, the next requests of the key start the new one
+  std::vector<Waiter> Finish()
+  {
+    std::lock_guard<std::mutex> lock{shard_.m};
+    const auto it = shard_.flights.find(key_);
+    if (it != shard_.flights.end() && it->second == this)
+    {
+      shard_.flights.erase(it);
+    }
+    return std::move(waiters_);
+  }
+
+  template <class Response>
+  void Deliver(std::vector<Waiter>&& waiters, Response&& response)
+  {
+    if (waiters.empty())
+    {
+      COMMON_LOG_WARNING() << "Response is already sent";
+      return;
+    }
+
+    // the last request takes the response, the others take the copies (the shared body isn't copied)
+    for (std::size_t i = 0; i < waiters.size(); i++)
+    {
+      auto& waiter = waiters[i];
+      auto copy = i + 1 == waiters.size() ? std::move(response) : response;
+      copy.version(waiter.version);
+      copy.keep_alive(waiter.keepAlive);
+      waiter.responder(std::move(copy));
+    }
+  }
+
+private:
+  /// @brief the shard outlives the flight
+  std::shared_ptr<Coalescer> owner_;
+  Shard& shard_;
+  const std::string key_;
+  std::vector<Waiter> waiters_;
+};
+
+Coalescer::Coalescer(const CoalesceOptions& options)
+: options_{options}
+{
+}
+
+std::string Coalescer::Key(const HttpRequest& request) const
+{
+  return MakeRequestKey(request, options_.vary);
+}
+
+std::optional<Responder> Coalescer::Join(const std::string& key, const HttpRequest& request, Responder responder)
+{
+  auto& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock{shard.m};
+
+  const auto it = shard.flights.find(key);
+  if (it != shard.flights.end())
+  {
+    it->second->Add(request, std::move(responder));
+    coalesced_.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+  }
+
+  auto flight = std::make_shared<Flight>(shared_from_this(), shard, key);
+  flight->Add(request, std::move(responder));
+  shard.flights.emplace(key, flight.get());
+  return Responder{std::move(flight)};
+}
+
+std::size_t Coalescer::Size() const
+{
+  std::size_t size = 0;
+  for (const auto& shard : shards_)
+  {
+    std::lock_guard<std::mutex> lock{shard.m};
+    size += shard.flights.size();
+  }
+  return size;
+}
+
+Coalescer::Shard& Coalescer::GetShard(const std::string& key)
+{
+  return shards_[std::hash<std::string>{}(key) % shardCount_];
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,416 @@
+//! @file compression.cpp
+//! @brief The implementation compression of the response body
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <charconv>
+#include <functional>
+
+// boost
+#include <boost/beast/zlib/deflate_stream.hpp>
+#include <boost/crc.hpp>
+
+// this
+#include <cmntype/http/compression.h>
+#include <cmntype/error/error.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace beast_http = boost::beast::http;
+namespace zlib = boost::beast::zlib;
+
+namespace
+{
+std::string_view Trim(std::string_view value)
+{
+  const auto first = value.find_first_not_of(" \t");
+  if (first == std::string_view::npos)
+  {
+    return {};
+  }
+  return value.substr(first, value.find_last_not_of(" \t") - first + 1);
+}
+
+/// @brief Parse the q-value of the coding, 'gzip;q=0.5' etc (thousandths)
+int Quality(std::string_view params)
+{
+  while (!params.empty())
+  {
+    const auto pos = params.find(';');
+    const auto param = Trim(params.substr(0, pos));
+    params.remove_prefix(pos == std::string_view::npos ? params.size() : pos + 1);
+
+    if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q') || param[1] != '=')
+    {
+      continue;
+    }
+
+    const auto value = param.substr(2);
+    if (value.empty() || value[0] == '0')
+    {
+      // 0, 0.5, 0.125
+      int result = 0;
+      auto fraction = value.size() > 2 ? value.substr(2, 3) : std::string_view{};
+      std::from_chars(fraction.data(), fraction.data() + fraction.size(), result);
+      for (auto i = fraction.size(); i < 3; i++)
+      {
+        result *= 10;
+      }
+      return result;
+    }
+    return 1000;
+  }
+  return 1000;
+}
+
+void PutLittleEndian(std::string& out, std::uint32_t value)
+{
+  for (int i = 0; i < 4; i++)
+  {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+void PutBigEndian(std::string& out, std::uint32_t value)
+{
+  for (int i = 3; i >= 0; i--)
+  {
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+std::uint32_t Adler32(std::string_view data)
+{
+  constexpr std::uint32_t mod = 65521;
+  std::uint32_t a = 1;
+  std::uint32_t b = 0;
+  while (!data.empty())
+  {
+    // the sums don't overflow in the block of 5552 bytes
+    const auto block = std::min<std::size_t>(data.size(), 5552);
+    for (std::size_t i = 0; i < block; i++)
+    {
+      a += static_cast<unsigned char>(data[i]);
+      b += a;
+    }
+    a %= mod;
+    b %= mod;
+    data.remove_prefix(block);
+  }
+  return (b << 16) | a;
+}
+
+bool IsEncoded(boost::beast::string_view encoding)
+{
+  // the legacy responses keep the charset in 'Content-Encoding' ('UTF-8')
+  using boost::beast::iequals;
+  return iequals(encoding, "gzip") || iequals(encoding, "x-gzip") || iequals(encoding, "deflate") ||
+         iequals(encoding, "br") || iequals(encoding, "compress") || iequals(encoding, "zstd");
+}
+
+/// @brief Add the header to 'Vary', the headers listed by the handler are kept
+void AddVary(HttpResponseHeader& response, std::string_view name)
+{
+  const auto vary = response[beast_http::field::vary];
+  std::string_view headers{vary.data(), vary.size()};
+
+  while (!headers.empty())
+  {
+    const auto pos = headers.find(',');
+    const auto header = Trim(headers.substr(0, pos));
+    headers.remove_prefix(pos == std::string_view::npos ? headers.size() : pos + 1);
+
+    if (header == "*" || boost::beast::iequals(boost::beast::string_view{header.data(), header.size()},
+                                               boost::beast::string_view{name.data(), name.size()}))
+    {
+      return;
+    }
+  }
+
+  std::string value{vary.data(), vary.size()};
+  value += value.empty() ? "" : ", ";
+  value += name;
+  response.set(beast_http::field::vary, value);
+}
+
+/// @brief The compressed body isn't byte-identical to the body of the ETag, so the validator becomes weak
+/// and still matches 'If-None-Match' of the both variants
+void WeakenETag(HttpResponseHeader& response)
+{
+  const auto etag = response[beast_http::field::etag];
+  if (etag.empty() || etag.starts_with("W/"))
+  {
+    return;
+  }
+  response.set(beast_http::field::etag, "W/" + std::string{etag.data(), etag.size()});
+}
+
+void SetCoding(HttpResponseHeader& response, ContentCoding coding)
+{
+  WeakenETag(response);
+  response.set(beast_http::field::content_encoding, coding == ContentCoding::gzip ? "gzip" : "deflate");
+}
+
+bool IsCompressible(boost::beast::string_view type)
+{
+  if (type.starts_with("image/"))
+  {
+    return type.starts_with("image/svg");
+  }
+  return !type.starts_with("video/") && !type.starts_with("audio/") && !type.starts_with("application/zip") &&
+         !type.starts_with("application/gzip") && !type.starts_with("application/octet-stream");
+}
+}  // namespace
+
+ContentCoding NegotiateCoding(std::string_view acceptEncoding)
+{
+  int gzip = -1;
+  int deflate = -1;
+  int any = -1;
+
+  while (!acceptEncoding.empty())
+  {
+    const auto pos = acceptEncoding.find(',');
+    const auto item = Trim(acceptEncoding.substr(0, pos));
+    acceptEncoding.remove_prefix(pos == std::string_view::npos ? acceptEncoding.size() : pos + 1);
+
+    const auto semicolon = item.find(';');
+    const auto name = Trim(item.substr(0, semicolon));
+    const auto quality = semicolon == std::string_view::npos ? 1000 : Quality(item.substr(semicolon + 1));
+    const boost::beast::string_view coding{name.data(), name.size()};
+
+    if (boost::beast::iequals(coding, "gzip") || boost::beast::iequals(coding, "x-gzip"))
+    {
+      gzip = quality;
+    }
+    else if (boost::beast::iequals(coding, "deflate"))
+    {
+      deflate = quality;
+    }
+    else if (coding == "*")
+    {
+      any = quality;
+    }
+  }
+
+  gzip = gzip < 0 ? any : gzip;
+  deflate = deflate < 0 ? any : deflate;
+
+  if (gzip > 0 && gzip >= deflate)
+  {
+    return ContentCoding::gzip;
+  }
+  return deflate > 0 ? ContentCoding::deflate : ContentCoding::identity;
+}
+
+std::string Compress(std::string_view data, ContentCoding coding, int level)
+{
+  if (coding == ContentCoding::identity)
+  {
+    return std::string{data};
+  }
+
+  // the stream allocates the window on the first use, it is reused by the thread
+  thread_local zlib::deflate_stream stream;
+  thread_local int streamLevel = -1;
+
+  if (streamLevel != level)
+  {
+    stream.reset(level, 15, 8, zlib::Strategy::normal);
+    streamLevel = level;
+  }
+  else
+  {
+    stream.reset();
+  }
+
+  std::string result;
+  const std::size_t header = coding == ContentCoding::gzip ? 10 : 2;
+  result.resize(header + stream.upper_bound(data.size()));
+
+  if (coding == ContentCoding::gzip)
+  {
+    // magic, deflate, no flags, no time, no extra flags, unknown OS
+    const char gzip[] = {'\x1f', '\x8b', '\x08', 0, 0, 0, 0, 0, 0, '\xff'};
+    result.replace(0, sizeof(gzip), gzip, sizeof(gzip));
+  }
+  else
+  {
+    // deflate, 32K window, the check bits of the default level
+    result[0] = '\x78';
+    result[1] = '\x9c';
+  }
+
+  zlib::z_params params;
+  params.next_in = data.data();
+  params.avail_in = data.size();
+  params.next_out = &result[header];
+  params.avail_out = result.size() - header;
+
+  boost::beast::error_code ec;
+  stream.write(params, zlib::Flush::finish, ec);
+  if (ec != zlib::error::end_of_stream)
+  {
+    streamLevel = -1;
+    THROW_COMMON_ERROR("Compression failed: " + ec.message());
+  }
+  result.resize(header + params.total_out);
+
+  if (coding == ContentCoding::gzip)
+  {
+    boost::crc_32_type crc;
+    crc.process_bytes(data.data(), data.size());
+    PutLittleEndian(result, crc.checksum());
+    PutLittleEndian(result, static_cast<std::uint32_t>(data.size()));
+  }
+  else
+  {
+    PutBigEndian(result, Adler32(data));
+  }
+
+  return result;
+}
+
+Compressor::Compressor(const Configuration::Compression& options)
+: options_{options}
+{
+}
+
+void Compressor::Apply(const HttpRequest& request, HttpResponse& response, bool cacheable) const
+{
+  auto& body = response.body();
+  const auto coding = Negotiate(request, response.base(), body.size());
+  if (coding == ContentCoding::identity)
+  {
+    return;
+  }
+
+  if (!cacheable)
+  {
+    body = Compress(body, coding, options_.level);
+  }
+  else
+  {
+    body = *Cached(body, coding, {});
+  }
+
+  SetCoding(response, coding);
+  response.prepare_payload();
+}
+
+void Compressor::Apply(const HttpRequest& request, SharedResponse& response, bool cacheable) const
+{
+  auto& body = response.body();
+  const std::string_view data{static_cast<const char*>(body.data()), body.size()};
+  const auto coding = Negotiate(request, response.base(), data.size());
+  if (coding == ContentCoding::identity)
+  {
+    return;
+  }
+
+  auto compressed = cacheable ? Cached(data, coding, body)
+                              : std::make_shared<const std::string>(Compress(data, coding, options_.level));
+  body = SharedBody::value_type{std::move(compressed)};
+
+  SetCoding(response, coding);
+  response.prepare_payload();
+}
+
+ContentCoding Compressor::Negotiate(const HttpRequest& request, HttpResponseHeader& header, std::size_t size) const
+{
+  if (!options_.enabled || size < options_.minSize || request.method() == beast_http::verb::head ||
+      header.result() == beast_http::status::no_content || header.result() == beast_http::status::not_modified ||
+      IsEncoded(header[beast_http::field::content_encoding]) || !IsCompressible(header[beast_http::field::content_type]))
+  {
+    return ContentCoding::identity;
+  }
+
+  const auto accept = request[beast_http::field::accept_encoding];
+  const auto coding = NegotiateCoding(std::string_view{accept.data(), accept.size()});
+
+  // the cached responses must not be reused for the clients with the other 'Accept-Encoding'
+  AddVary(header, "Accept-Encoding");
+  return coding;
+}
+
+Compressor::Body Compressor::Cached(std::string_view body, ContentCoding coding, SharedBody::value_type uncompressed) const
+{
+  const auto key = std::hash<std::string_view>{}(body) ^ static_cast<std::size_t>(coding);
+  auto compressed = Find(key, coding, body);
+
+  if (!compressed)
+  {
+    compressed = std::make_shared<const std::string>(Compress(body, coding, options_.level));
+    // the buffer without the owner may not outlive the response
+    if (!uncompressed.owner())
+    {
+      uncompressed = SharedBody::value_type{std::make_shared<const std::string>(body)};
+    }
+    Store(key, coding, std::move(uncompressed), compressed);
+  }
+
+  return compressed;
+}
+
+std::size_t Compressor::CacheSize() const
+{
+  std::lock_guard<std::mutex> lock{m_};
+  return entries_.size();
+}
+
+Compressor::Body Compressor::Find(std::size_t key, ContentCoding coding, std::string_view body) const
+{
+  SharedBody::value_type cached;
+  Body compressed;
+  {
+    std::lock_guard<std::mutex> lock{m_};
+
+    auto it = entries_.find(key);
+    if (it == entries_.end() || it->second.coding != coding || it->second.body.size() != body.size())
+    {
+      return {};
+    }
+
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    cached = it->second.body;
+    compressed = it->second.compressed;
+  }
+
+  // the bodies are compared outside the lock
+  return std::string_view{static_cast<const char*>(cached.data()), cached.size()} == body ? compressed : Body{};
+}
+
+void Compressor::Store(std::size_t key, ContentCoding coding, SharedBody::value_type body, Body compressed) const
+{
+  if (!options_.cacheSize)
+  {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock{m_};
+
+  auto it = entries_.find(key);
+  if (it != entries_.end())
+  {
+    // the collision of the hash, the entry is replaced
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+  }
+
+  while (entries_.size() >= options_.cacheSize)
+  {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+
+  lru_.push_front(key);
+  entries_.emplace(key, Entry{coding, std::move(body), std::move(compressed), lru_.begin()});
+}
+
+}  // namespace http
+}  // namespace common
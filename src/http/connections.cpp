@@ -0,0 +1,71 @@
+//! @file connections.cpp
+//! @brief The implementation registry of the open connections of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <atomic>
+
+// this
+#include <cmntype/http/connections.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace
+{
+/// @brief Index of the shard of the current thread
+std::size_t ShardIndex(std::size_t count) noexcept
+{
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+  return index % count;
+}
+}  // namespace
+
+void Connections::Add(const std::shared_ptr<Connection>& connection)
+{
+  auto& shard = shards_[ShardIndex(shards_.size())];
+  std::lock_guard<std::mutex> lock{shard.m};
+
+  auto& connections = shard.connections;
+  if (connections.size() >= shard.prune)
+  {
+    connections.erase(std::remove_if(connections.begin(), connections.end(), [](const auto& weak) { return weak.expired(); }),
+        connections.end());
+    shard.prune = std::max(connections.size() * 2, minPrune_);
+  }
+
+  connections.push_back(connection);
+}
+
+void Connections::ForEach(const std::function<void(Connection&)>& function) const
+{
+  for (const auto& shard : shards_)
+  {
+    std::vector<std::shared_ptr<Connection>> connections;
+    {
+      std::lock_guard<std::mutex> lock{shard.m};
+      connections.reserve(shard.connections.size());
+      for (const auto& weak : shard.connections)
+      {
+        if (auto connection = weak.lock())
+        {
+          connections.push_back(std::move(connection));
+        }
+      }
+    }
+
+    for (const auto& connection : connections)
+    {
+      function(*connection);
+    }
+  }
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,219 @@
+//! @file event_stream.cpp
+//! @brief The implementation stream of the server-sent events
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <atomic>
+
+// this
+#include <cmntype/http/event_stream.h>
+#include <cmntype/logger/logger.h>
+
+namespace common
+{
+namespace http
+{
+
+class EventStream::State final : public std::enable_shared_from_this<State>
+{
+public:
+  State(ResponseWriter writer, const EventStreamOptions& options)
+    : writer_{std::move(writer)}
+    , options_{options}
+  {
+  }
+
+  ~State()
+  {
+    Close();
+  }
+
+  bool Push(std::string_view event)
+  {
+    std::lock_guard<std::mutex> lock{m_};
+    if (!open_)
+    {
+      return false;
+    }
+
+    if (pending_.size() + event.size() > options_.bufferLimit)
+    {
+      COMMON_LOG_WARNING() << "Buffer of the event stream is full, the stream is closed";
+      pending_.clear();
+      Stop();
+      return false;
+    }
+
+    pending_.append(event);
+    if (!writing_)
+    {
+      Flush();
+    }
+    return true;
+  }
+
+  void Close()
+  {
+    std::lock_guard<std::mutex> lock{m_};
+    if (!open_)
+    {
+      return;
+    }
+
+    // the buffered events are written before the end of the stream
+    if (!pending_.empty())
+    {
+      writer_.Write(std::move(pending_));
+      pending_.clear();
+    }
+    Stop();
+  }
+
+  bool IsOpen() const noexcept
+  {
+    return open_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void Flush()
+  {
+    writing_ = true;
+    writer_.Write(std::move(pending_), [weak = weak_from_this()](boost::beast::error_code ec)
+        {
+          if (const auto self = weak.lock())
+          {
+            self->HandleWrite(ec);
+          }
+        });
+    pending_.clear();
+  }
+
+  void HandleWrite(boost::beast::error_code ec)
+  {
+    std::lock_guard<std::mutex> lock{m_};
+    writing_ = false;
+
+    if (ec)
+    {
+      COMMON_LOG_DEBUG() << "Event stream is closed: " << ec.message();
+      open_ = false;
+      pending_.clear();
+      return;
+    }
+
+    // the events received during the write are sent by one chunk
+    if (open_ && !pending_.empty())
+    {
+      Flush();
+    }
+  }
+
+  void Stop()
+  {
+    open_ = false;
+    writer_.End();
+  }
+
+private:
+  std::mutex m_;
+  ResponseWriter writer_;
+  const EventStreamOptions options_;
+  std::string pending_;
+  bool writing_{false};
+  std::atomic<bool> open_{true};
+};
+
+EventStream::EventStream(ResponseWriter writer, const EventStreamOptions& options)
+: state_{std::make_shared<State>(std::move(writer), options)}
+{
+}
+
+bool EventStream::Send(std::string_view data, std::string_view event, std::string_view id) const
+{
+  return Push(Format(data, event, id));
+}
+
+void EventStream::Close() const
+{
+  state_->Close();
+}
+
+bool EventStream::IsOpen() const noexcept
+{
+  return state_->IsOpen();
+}
+
+bool EventStream::Push(std::string_view formatted) const
+{
+  return state_->Push(formatted);
+}
+
+std::string EventStream::Format(std::string_view data, std::string_view event, std::string_view id)
+{
+  std::string result;
+  result.reserve(data.size() + event.size() + id.size() + 32);
+
+  if (!id.empty())
+  {
+    result.append("id: ").append(id).push_back('\n');
+  }
+  if (!event.empty())
+  {
+    result.append("event: ").append(event).push_back('\n');
+  }
+
+  // each line of the data is the separate field, the client joins them by '\n'
+  while (true)
+  {
+    const auto end = data.find('\n');
+    auto line = data.substr(0, end);
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.remove_suffix(1);
+    }
+    result.append("data: ").append(line).push_back('\n');
+
+    if (end == std::string_view::npos)
+    {
+      break;
+    }
+    data.remove_prefix(end + 1);
+  }
+
+  result.push_back('\n');
+  return result;
+}
+
+void EventChannel::Join(const EventStream& stream)
+{
+  std::lock_guard<std::mutex> lock{m_};
+  streams_.push_back(stream.state_);
+}
+
+std::size_t EventChannel::Publish(std::string_view data, std::string_view event, std::string_view id)
+{
+  const auto formatted = EventStream::Format(data, event, id);
+
+  std::lock_guard<std::mutex> lock{m_};
+
+  const auto end = std::remove_if(streams_.begin(), streams_.end(), [&formatted](const auto& weak)
+      {
+        const auto state = weak.lock();
+        return !state || !state->Push(formatted);
+      });
+  streams_.erase(end, streams_.end());
+
+  return streams_.size();
+}
+
+std::size_t EventChannel::Size() const
+{
+  std::lock_guard<std::mutex> lock{m_};
+  return streams_.size();
+}
+
+}  // namespace http
+}  // namespace common
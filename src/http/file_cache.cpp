@@ -0,0 +1,169 @@
+//! @file file_cache.cpp
+//! @brief The implementation cache of the open files
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <cerrno>
+#include <cstdio>
+
+// posix
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// boost
+#include <boost/asio/error.hpp>
+
+// this
+#include <cmntype/http/file_cache.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace
+{
+std::string FormatHttpDate(std::time_t time)
+{
+  std::tm tm{};
+#if defined(_WIN32)
+  gmtime_s(&tm, &time);
+#else
+  gmtime_r(&time, &tm);
+#endif
+  char buffer[64];
+  const auto size = std::strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm);
+  return std::string(buffer, size);
+}
+}  // namespace
+
+File::File(int handle, std::uint64_t size, std::uint64_t inode, std::time_t modified)
+: handle_{handle}
+, size_{size}
+, inode_{inode}
+, modified_{modified}
+, lastModified_{FormatHttpDate(modified)}
+{
+  char etag[64];
+  const auto count = std::snprintf(etag, sizeof(etag), "\"%llx-%llx\"", static_cast<unsigned long long>(modified),
+                                   static_cast<unsigned long long>(size));
+  etag_.assign(etag, count);
+}
+
+File::~File()
+{
+#if !defined(_WIN32)
+  ::close(handle_);
+#endif
+}
+
+FileCache::FileCache(std::size_t capacity, Clock::duration revalidate)
+: capacity_{capacity}
+, revalidate_{revalidate}
+{
+}
+
+FileCache::FilePtr FileCache::OpenFile(const std::string& path, boost::beast::error_code& ec)
+{
+#if defined(_WIN32)
+  ec = boost::asio::error::operation_not_supported;
+  return nullptr;
+#else
+  const int handle = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (handle < 0)
+  {
+    ec.assign(errno, boost::system::generic_category());
+    return nullptr;
+  }
+
+  struct stat st{};
+  if (::fstat(handle, &st) != 0 || !S_ISREG(st.st_mode))
+  {
+    ec = boost::system::errc::make_error_code(boost::system::errc::no_such_file_or_directory);
+    ::close(handle);
+    return nullptr;
+  }
+
+  return std::make_shared<const File>(handle, static_cast<std::uint64_t>(st.st_size), static_cast<std::uint64_t>(st.st_ino), st.st_mtime);
+#endif
+}
+
+FileCache::FilePtr FileCache::Open(const std::string& path, boost::beast::error_code& ec)
+{
+  ec = {};
+  const auto now = Clock::now();
+
+  {
+    std::lock_guard<std::mutex> lock{m_};
+
+    auto it = entries_.find(path);
+    if (it != entries_.end())
+    {
+      auto& entry = it->second;
+      bool valid = now - entry.checked < revalidate_;
+
+#if !defined(_WIN32)
+      if (!valid)
+      {
+        struct stat st{};
+        const auto& file = *entry.file;
+        valid = ::stat(path.c_str(), &st) == 0 && static_cast<std::uint64_t>(st.st_ino) == file.Inode() &&
+                static_cast<std::uint64_t>(st.st_size) == file.Size() && st.st_mtime == file.Modified();
+        entry.checked = now;
+      }
+#endif
+
+      if (valid)
+      {
+        lru_.splice(lru_.begin(), lru_, entry.lru);
+        return entry.file;
+      }
+
+      lru_.erase(entry.lru);
+      entries_.erase(it);
+    }
+  }
+
+  auto file = OpenFile(path, ec);
+  if (!file || !capacity_)
+  {
+    return file;
+  }
+
+  std::lock_guard<std::mutex> lock{m_};
+
+  auto it = entries_.find(path);
+  if (it != entries_.end())
+  {
+    // opened by the other thread
+    it->second.file = file;
+    it->second.checked = now;
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return file;
+  }
+
+  while (entries_.size() >= capacity_)
+  {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+
+  lru_.push_front(path);
+  entries_.emplace(path, Entry{file, now, lru_.begin()});
+
+  return file;
+}
+
+std::size_t FileCache::Size() const
+{
+  std::lock_guard<std::mutex> lock{m_};
+  return entries_.size();
+}
+
+}  // namespace http
+}  // namespace common
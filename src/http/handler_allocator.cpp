@@ -0,0 +1,111 @@
+//! @file handler_allocator.cpp
+//! @brief The implementation recycling allocator of the handlers and the sessions
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <array>
+
+// this
+#include <cmntype/http/handler_allocator.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace
+{
+/// @brief Cache of the thread, the blocks are freed at the exit of the thread
+class Cache final
+{
+public:
+  ~Cache()
+  {
+    // the blocks freed by the destructors of the other thread-local objects bypass the cache
+    closed_ = true;
+    for (auto& blocks : classes_)
+    {
+      for (std::size_t i = 0; i < blocks.count; i++)
+      {
+        ::operator delete(blocks.items[i]);
+      }
+      blocks.count = 0;
+    }
+  }
+
+  void* Take(std::size_t index) noexcept
+  {
+    auto& blocks = classes_[index];
+    return blocks.count ? blocks.items[--blocks.count] : nullptr;
+  }
+
+  bool Put(std::size_t index, void* pointer) noexcept
+  {
+    auto& blocks = classes_[index];
+    if (closed_ || blocks.count == RecyclingPool::cacheLimit)
+    {
+      return false;
+    }
+    blocks.items[blocks.count++] = pointer;
+    return true;
+  }
+
+private:
+  struct Blocks
+  {
+    std::array<void*, RecyclingPool::cacheLimit> items{};
+    std::size_t count{0};
+  };
+
+  std::array<Blocks, RecyclingPool::classCount> classes_;
+  bool closed_{false};
+};
+
+thread_local Cache cache;
+
+/// @brief Size class of the block, classCount if the block isn't cached
+std::size_t ClassOf(std::size_t size) noexcept
+{
+  std::size_t index = 0;
+  for (std::size_t capacity = RecyclingPool::minSize; capacity < size; capacity <<= 1)
+  {
+    index++;
+  }
+  return std::min(index, RecyclingPool::classCount);
+}
+}  // namespace
+
+void* RecyclingPool::Allocate(std::size_t size)
+{
+  const auto index = ClassOf(size);
+  if (index == classCount)
+  {
+    return ::operator new(size);
+  }
+
+  if (auto* pointer = cache.Take(index))
+  {
+    return pointer;
+  }
+  return ::operator new(minSize << index);
+}
+
+void RecyclingPool::Deallocate(void* pointer, std::size_t size) noexcept
+{
+  if (!pointer)
+  {
+    return;
+  }
+
+  const auto index = ClassOf(size);
+  if (index == classCount || !cache.Put(index, pointer))
+  {
+    ::operator delete(pointer);
+  }
+}
+
+}  // namespace http
+}  // namespace common
@@ -18,20 +18,50 @@ namespace http
 
 namespace beast_http = boost::beast::http;
 
+namespace
+{
+template <class Body>
+void SetHeader(const HttpRequest& request, boost::beast::http::response<Body>& response,
+    std::string_view contentType, std::string_view encoding)
+{
+  response.set(beast_http::field::server, BOOST_BEAST_VERSION_STRING);
+  response.set(beast_http::field::content_type, boost::beast::string_view{contentType.data(), contentType.size()});
+  response.set(beast_http::field::content_encoding, boost::beast::string_view{encoding.data(), encoding.size()});
+  response.keep_alive(request.keep_alive());
+}
+}  // namespace
+
+HttpResponse MakeResponse(const HttpRequest& request,
+    boost::beast::http::status status,
+    std::string_view contentType, std::string_view encoding)
+{
+  HttpResponse response{status, request.version()};
+  SetHeader(request, response, contentType, encoding);
+  response.prepare_payload();
+  return response;
+}
+
 HttpResponse MakeResponse(const HttpRequest& request,
     boost::beast::http::status status,
     std::string_view contentType, std::string_view encoding,
     std::string_view data)
 {
   HttpResponse response{status, request.version()};
-
-  response.set(beast_http::field::server, BOOST_BEAST_VERSION_STRING);
-  response.set(beast_http::field::content_type, contentType.data());
-  response.set(beast_http::field::content_encoding, encoding.data());
-  response.keep_alive(request.keep_alive());
-  response.body() = std::string(data);
+  SetHeader(request, response, contentType, encoding);
+  response.body().assign(data.data(), data.size());
   response.prepare_payload();
+  return response;
+}
 
+SharedResponse MakeSharedResponse(const HttpRequest& request,
+    boost::beast::http::status status,
+    std::string_view contentType, std::string_view encoding,
+    SharedBody::value_type body)
+{
+  SharedResponse response{status, request.version()};
+  SetHeader(request, response, contentType, encoding);
+  response.body() = std::move(body);
+  response.prepare_payload();
   return response;
 }
 
@@ -59,6 +89,16 @@ HttpResponse MakeResponseForNotAllowed(const HttpRequest& request,
       contentType, encoding, data);
 }
 
+HttpResponse MakeResponseForPayloadTooLarge(const HttpRequest& request,
+    std::string_view contentType, std::string_view encoding,
+    std::string_view data)
+{
+  auto response = MakeResponse(request, boost::beast::http::status::payload_too_large,
+      contentType, encoding, data);
+  response.keep_alive(false);
+  return response;
+}
+
 HttpResponse MakeResponseForServerError(const HttpRequest& request,
     std::string_view contentType, std::string_view encoding,
     std::string_view data)
@@ -66,6 +106,45 @@ HttpResponse MakeResponseForServerError(const HttpRequest& request,
   return MakeResponse(request, boost::beast::http::status::internal_server_error,
       contentType, encoding, data);
 }
+
+HttpResponse MakeResponseForNotModified(const HttpRequest& request, std::string_view etag)
+{
+  HttpResponse response{beast_http::status::not_modified, request.version()};
+
+  response.set(beast_http::field::server, BOOST_BEAST_VERSION_STRING);
+  response.set(beast_http::field::etag, boost::beast::string_view{etag.data(), etag.size()});
+  response.keep_alive(request.keep_alive());
+
+  return response;
+}
+
+bool IsNotModified(const HttpRequest& request, std::string_view etag)
+{
+  const auto header = request[beast_http::field::if_none_match];
+  const std::string_view value{header.data(), header.size()};
+  return !value.empty() && !etag.empty() && (value == "*" || value.find(etag) != std::string_view::npos);
+}
+
+std::string MakeRequestKey(const HttpRequest& request, const std::vector<std::string>& vary)
+{
+  const auto method = request.method_string();
+  const auto target = request.target();
+
+  std::string key;
+  key.reserve(method.size() + target.size() + 1);
+  key.append(method.data(), method.size());
+  key.push_back(' ');
+  key.append(target.data(), target.size());
+
+  for (const auto& name : vary)
+  {
+    const auto value = request[name];
+    key.push_back('\n');
+    key.append(value.data(), value.size());
+  }
+
+  return key;
+}
     
 }
 }
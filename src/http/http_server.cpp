@@ -6,21 +6,29 @@
  */
 
 // std
+#include <algorithm>
 #include <thread>
-#include <shared_mutex>
+#include <vector>
 
 // boost
 #include <boost/asio.hpp>
 #include <boost/assert.hpp>
 #include <boost/bind/bind.hpp>
-#include <boost/thread.hpp>
 #include <boost/format.hpp>
 
 // this
 #include <cmntype/http/http_server.h>
+#include <cmntype/http/coalescer.h>
 #include <cmntype/http/types.h>
 #include <cmntype/http/http_response.h>
+#include <cmntype/http/rate_limiter.h>
+#include <cmntype/http/response_cache.h>
+#include <cmntype/http/server_state.h>
+#include <cmntype/http/timer_wheel.h>
 #include <cmntype/http/session.h>
+#include <cmntype/http/responder.h>
+#include <cmntype/http/response_writer.h>
+#include <cmntype/http/router_registry.h>
 #include <cmntype/logger/logger.h>
 #include <cmntype/thread/thread_safe.h>
 #include <cmntype/common/stopwatch.h>
@@ -32,17 +40,23 @@ namespace common
 namespace http
 {
 
-using Mutex = std::shared_mutex;
+#ifdef SO_REUSEPORT
+using ReusePort = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
 
 class Listener : public std::enable_shared_from_this<Listener>
 {
 public:
   explicit Listener(boost::asio::io_context& ioc,
-      boost::asio::ip::tcp::endpoint endpoint, Handlers& handlers)
+      boost::asio::ip::tcp::endpoint endpoint, std::shared_ptr<ServerState> state, TimerWheel& wheel)
   : io_{ioc}
   , endpoint_{endpoint}
   , acceptor_{boost::asio::make_strand(ioc)}
-  , handlers_{handlers}
+  , timer_{acceptor_.get_executor()}
+  , state_{std::move(state)}
+  , wheel_{wheel}
+  , overload_{(boost::format("HTTP/1.1 503 Service Unavailable\r\nRetry-After: %1%\r\nContent-Length: 0\r\nConnection: close\r\n\r\n")
+      % state_->config.limits.retryAfter.count()).str()}
   {
     
   }
@@ -57,6 +71,16 @@ public:
     acceptor_.set_option(boost::asio::socket_base::reuse_address(true), ec);
     THROW_IF_ERROR(ec);
 
+    if (Configuration::Threading::per_thread == state_->config.threading)
+    {
+#ifdef SO_REUSEPORT
+      acceptor_.set_option(ReusePort(true), ec);
+      THROW_IF_ERROR(ec);
+#else
+      THROW_COMMON_ERROR("SO_REUSEPORT isn't supported by the platform");
+#endif
+    }
+
     acceptor_.bind(endpoint_, ec);
     THROW_IF_ERROR(ec);
 
@@ -75,145 +99,455 @@ public:
   {
     COMMON_LOG_DEBUG() << "Stoping the listener";
     
+    // the flag is set before the cancel, so the cancelled accept isn't restarted
+    stop_ = true;
     acceptor_.cancel();
     acceptor_.close();
-    stop_ = true;
+    timer_.cancel();
 
     COMMON_LOG_INFO() << "Listener is stopped";
   }
 
-  void SetHandlers(const Handlers& handlers)
-  {
-    std::unique_lock<Mutex> lock{m_};
-
-    handlers_ = handlers;
-  }
-
 private:
   void Accept()
   {
     acceptor_.async_accept(boost::asio::make_strand(io_), boost::beast::bind_front_handler(&Listener::OnAccept, shared_from_this()));
   }
   
-  void OnAccept(boost::beast::error_code ec, boost::asio::ip::tcp::socket socket)
+  /// @brief the socket is accepted with the type of the new strand
+  void OnAccept(boost::beast::error_code ec, ConnectionSocket socket)
   {
+    if (stop_)
+    {
+      return;
+    }
+
     if (ec)
     {
       COMMON_LOG_ERROR() << "accept: " << ec.message();
-      if (stop_)
-      {
-        return;
-      }
     }
-    else
+    else if (auto connection = state_->admission.AdmitConnection())
     {
-      std::shared_ptr<Session> session;
-      {
-        std::shared_lock<Mutex> lock{m_};
-        session = std::make_shared<Session>(std::move(socket), handlers_);
-      }
+      // the memory of the closed sessions is reused by the new connections of the thread
+      auto session = std::allocate_shared<Session>(HandlerAllocator<Session>{}, std::move(socket), state_, std::move(connection), wheel_);
+      state_->connections.Add(session);
       session->Run();
     }
+    else
+    {
+      Shed(std::move(socket));
+    }
+
+    const auto& limits = state_->config.limits;
+    if (Configuration::Limits::Overload::pause == limits.overload && state_->admission.IsFull())
+    {
+      return Pause();
+    }
 
     Accept();
   }
 
+  /// @brief Reply 503 to the connection over the limit and close it
+  void Shed(ConnectionSocket&& socket)
+  {
+    COMMON_LOG_WARNING() << "Limit of the connections is reached, the connection is rejected";
+
+    auto shed = std::make_shared<ConnectionSocket>(std::move(socket));
+    boost::asio::async_write(*shed, boost::asio::buffer(overload_),
+        [self = shared_from_this(), shed](boost::beast::error_code, std::size_t)
+        {
+          boost::beast::error_code ec;
+          shed->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ec);
+        });
+  }
+
+  /// @brief Wait for the release of the connection, the new connections wait in the backlog
+  void Pause()
+  {
+    state_->admission.Pause();
+
+    timer_.expires_after(state_->config.limits.acceptPause);
+    timer_.async_wait([self = shared_from_this()](boost::beast::error_code ec)
+        {
+          if (ec || self->stop_)
+          {
+            return;
+          }
+
+          if (self->state_->admission.IsFull())
+          {
+            return self->Pause();
+          }
+
+          self->Accept();
+        });
+  }
+
 private:
   boost::asio::io_context& io_;
   boost::asio::ip::tcp::endpoint endpoint_;
   boost::asio::ip::tcp::acceptor acceptor_;
-  Handlers handlers_;
+  boost::asio::steady_timer timer_;
+  std::shared_ptr<ServerState> state_;
+  TimerWheel& wheel_;
+  /// @brief response to the connection over the limit
+  std::string overload_;
   std::atomic<bool> stop_{false};
-  Mutex m_;
   
 };
 
 class HttpServer::Impl final
 {
 public:
-  Impl(const std::string_view address, std::uint16_t port, std::uint16_t threads)
-  : io_{threads}
+  Impl(const std::string_view address, std::uint16_t port, std::uint16_t threads, const Configuration& config)
+  : state_{std::make_shared<ServerState>(config)}
   , protocol_{boost::asio::ip::make_address(address.data()), port}
-  , listener_{std::make_shared<Listener>(io_, protocol_, handlers_)}
   , countThr_{threads}
-  , exit_{false}
   {
+    if (Configuration::IoBackend::automatic != config.ioBackend && HttpServer::GetIoBackend() != config.ioBackend)
+    {
+      THROW_COMMON_ERROR(Configuration::IoBackend::io_uring == config.ioBackend
+          ? "The io backend io_uring isn't built, see BUILD_WITH_IO_URING"
+          : "The io backend epoll isn't built, the server is built with io_uring");
+    }
+
+    if (!config.metrics.path.empty())
+    {
+      // the state owns the route, so the handler doesn't own the state
+      AddRequestHandler(config.metrics.path, boost::beast::http::verb::get, [state = state_.get()](const HttpRequest& request)
+          {
+            auto response = MakeResponse(request, boost::beast::http::status::ok, "text/plain; version=0.0.4", "UTF-8",
+                state->metrics.Format(state->admission.GetStats()));
+            response.erase(boost::beast::http::field::content_encoding);
+            response.set(boost::beast::http::field::cache_control, "no-store");
+            return response;
+          }, RouteOptions{});
+    }
+  }
+
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler, const RouteOptions& options)
+  {
+    Context context{method};
+    context.handler = std::move(handler);
+    context.options = options;
+    AddRoute(uri, std::move(context));
+  }
+
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RouteRequestHandler handler, const RouteOptions& options)
+  {
+    Context context{method};
+    context.routeHandler = std::move(handler);
+    context.options = options;
+    AddRoute(uri, std::move(context));
   }
 
-  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler)
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, AsyncRequestHandler handler, const RouteOptions& options)
   {
-    COMMON_LOG_TRACE() << "Adding handler uri = '" << std::string(uri) << "', method = '" << method << "'";
+    Context context{method};
+    context.asyncHandler = std::move(handler);
+    context.options = options;
+    AddRoute(uri, std::move(context));
+  }
 
-    auto handlers = handlers_.equal_range(std::string(uri));
+  void AddStreamRequestHandler(const std::string_view uri, boost::beast::http::verb method, StreamRequestHandler handler, const RouteOptions& options)
+  {
+    Context context{method};
+    context.streamHandler = std::move(handler);
+    context.options = options;
+    AddRoute(uri, std::move(context));
+  }
 
-    auto contextIt = std::end(handlers_);
+  void AddStreamResponseHandler(const std::string_view uri, boost::beast::http::verb method, StreamResponseHandler handler, const RouteOptions& options)
+  {
+    Context context{method};
+    context.streamResponseHandler = std::move(handler);
+    context.options = options;
+    AddRoute(uri, std::move(context));
+  }
 
-    for (auto it = handlers.first; it != handlers.second; ++it)
+  void AddResponse(const std::string_view uri, boost::beast::http::verb method, ResponseTemplatePtr response)
+  {
+    if (!response)
     {
-      if (it->second.method == method)
-      {
-        contextIt = it;
-      }
+      THROW_COMMON_ERROR("Response of the route is null");
     }
 
-    if (std::end(handlers_) == contextIt)
+    Context context{method};
+    context.response = std::move(response);
+    AddRoute(uri, std::move(context));
+  }
+
+  void AddStaticFiles(const std::string_view uri, const filesystem::path& root, const StaticFilesOptions& options)
+  {
+    auto files = std::make_shared<const StaticFiles>(root, options);
+
+    auto prefix = std::string(uri);
+    while (!prefix.empty() && prefix.back() == '/')
     {
-      Context context{method, handler};
-      handlers_.emplace(std::string(uri), context);
+      prefix.pop_back();
     }
-    else
+    prefix += "/*";
+
+    for (const auto method : {boost::beast::http::verb::get, boost::beast::http::verb::head})
     {
-      contextIt->second.handler = handler;
+      Context context{method};
+      context.files = files;
+      AddRoute(prefix, std::move(context));
     }
+  }
+
+  void AddWebSocketHandler(const std::string_view uri, WebSocketHandler handler, const WebSocketOptions& options)
+  {
+    Context context{boost::beast::http::verb::get};
+    context.webSocket = std::make_shared<const WebSocketRoute>(WebSocketRoute{std::move(handler), options});
+    AddRoute(uri, std::move(context));
+  }
+
+  void AddEventStreamHandler(const std::string_view uri, EventStreamHandler handler, const EventStreamOptions& options)
+  {
+    Context context{boost::beast::http::verb::get};
+    context.longLived = true;
+    context.streamResponseHandler = [handler = std::move(handler), options](const HttpRequest& request, ResponseWriter writer)
+        {
+          HttpResponseHeader header;
+          header.result(boost::beast::http::status::ok);
+          header.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
+          header.set(boost::beast::http::field::content_type, "text/event-stream");
+          header.set(boost::beast::http::field::cache_control, "no-cache");
+          writer.Begin(std::move(header));
+
+          handler(request, EventStream{std::move(writer), options});
+        };
+    AddRoute(uri, std::move(context));
+  }
 
-    listener_->SetHandlers(handlers_);
+  void AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler,
+      std::shared_ptr<thread::PoolThread> pool, const RouteOptions& options)
+  {
+    auto shared = std::make_shared<const RequestHandler>(std::move(handler));
+
+    AsyncRequestHandler async = [handler = std::move(shared), pool = std::move(pool)](const HttpRequest& request, Responder responder)
+        {
+          pool->Post([handler, &request, responder]
+              {
+                try
+                {
+                  responder((*handler)(request));
+                }
+                catch (const std::exception& e)
+                {
+                  COMMON_LOG_ERROR() << "Request handler failed: " << e.what();
+                  responder(MakeResponseForServerError(request, "application/json", "UTF-8", "internal server error"));
+                }
+                return 0;
+              });
+        };
+
+    AddRequestHandler(uri, method, std::move(async), options);
+  }
 
-    COMMON_LOG_TRACE() << "Total count handlers: " << handlers_.size();
+  ~Impl()
+  {
+    Stop();
   }
 
   void Start()
   {
-    if (io_.stopped())
+    if (started_)
+    {
+      return;
+    }
+
+    Create();
+
+    try
+    {
+      for (auto& wheel : wheels_)
+      {
+        wheel->Start();
+      }
+
+      for (auto& listener : listeners_)
+      {
+        listener->Start();
+      }
+    }
+    catch (...)
     {
-      io_.restart();
+      for (auto& wheel : wheels_)
+      {
+        wheel->Stop();
+      }
+      Release();
+      throw;
     }
 
-    listener_->Start();
+    for (auto& io : ios_)
+    {
+      io->restart();
+    }
 
+    // the guards keep the threads in run() while the contexts are without work
     for (std::uint16_t i = 0; i < countThr_; i++)
     {
-      threads_.create_thread([this]
-          {
-            while (!exit_)
-            {
-              io_.run();
-              std::this_thread::sleep_for(waitMs_);
-            }
-          });
+      threads_.emplace_back([&io = *ios_[i % ios_.size()]] { io.run(); });
     }
+
+    started_ = true;
   }
 
   void Stop()
   {
-    listener_->Stop();
-    io_.stop();
-    exit_ = true;
-    threads_.join_all();
+    if (!started_)
+    {
+      return;
+    }
+
+    for (auto& listener : listeners_)
+    {
+      listener->Stop();
+    }
+
+    Drain();
+
+    for (auto& wheel : wheels_)
+    {
+      wheel->Stop();
+    }
+
+    for (auto& io : ios_)
+    {
+      io->stop();
+    }
+
+    for (auto& thread : threads_)
+    {
+      thread.join();
+    }
+
+    Release();
+    started_ = false;
   }
 
 private:
-  boost::asio::io_context io_;
-  Handlers handlers_;
+  /// @brief Create the listeners of the start. The contexts and the wheels are created by the first start and live
+  /// as long as the server, the sessions kept by the application after the stop still refer to them
+  void Create()
+  {
+    const auto& config = state_->config;
+    const bool perThread = Configuration::Threading::per_thread == config.threading;
+    const std::size_t count = perThread ? std::max<std::size_t>(countThr_, 1) : 1;
+
+    state_->draining = false;
+
+    for (std::size_t i = ios_.size(); i < count; i++)
+    {
+      ios_.push_back(std::make_unique<boost::asio::io_context>(perThread ? 1 : countThr_));
+      guards_.push_back(boost::asio::make_work_guard(*ios_.back()));
+      wheels_.push_back(std::make_unique<TimerWheel>(*ios_.back(), config.timeouts.resolution));
+    }
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+      listeners_.push_back(std::make_shared<Listener>(*ios_[i], protocol_, state_, *wheels_[i]));
+    }
+  }
+
+  /// @brief Close the connections left after the drain, the threads are stopped, so the sockets are closed
+  /// without the races. The completions of the cancelled operations release the sessions,
+  /// the sessions kept by the application are released later by their handlers
+  void Release()
+  {
+    threads_.clear();
+    listeners_.clear();
+
+    state_->connections.ForEach([](Connections::Connection& connection) { connection.Abort(); });
+
+    for (auto& io : ios_)
+    {
+      io->restart();
+      io->poll();
+    }
+  }
+
+  /// @brief Wait for the requests in flight, the sessions close the connections after their responses.
+  /// The event streams and the WebSocket sessions aren't waited, they are ended at once
+  void Drain()
+  {
+    state_->draining = true;
+    state_->connections.ForEach([](Connections::Connection& connection) { connection.Shutdown(); });
+
+    const auto deadline = std::chrono::steady_clock::now() + state_->config.timeouts.drain;
+    while (state_->admission.GetStats().requests && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(drainMs_);
+    }
+
+    if (const auto requests = state_->admission.GetStats().requests)
+    {
+      COMMON_LOG_WARNING() << "Drain timeout, " << requests << " requests in flight are dropped";
+    }
+  }
+
+  void AddRoute(const std::string_view uri, Context context)
+  {
+    COMMON_LOG_TRACE() << "Adding handler uri = '" << std::string(uri) << "', method = '" << context.method << "'";
+
+    if (context.options.cache)
+    {
+      context.cache = std::make_shared<ResponseCache>(*context.options.cache);
+    }
+
+    if (context.options.rateLimit)
+    {
+      context.rateLimiter = std::make_shared<RateLimiter>(*context.options.rateLimit);
+    }
+
+    if (context.options.coalesce)
+    {
+      context.coalescer = std::make_shared<Coalescer>(*context.options.coalesce);
+    }
+
+    context.metrics = state_->metrics.Route(uri, context.method);
+
+    state_->registry->Add(uri, std::move(context));
+
+    COMMON_LOG_TRACE() << "Total count handlers: " << state_->registry->Get()->Size();
+  }
+
+public:
+  ServerStats GetStats() const
+  {
+    return state_->admission.GetStats();
+  }
+
+  std::string GetMetrics() const
+  {
+    return state_->metrics.Format(state_->admission.GetStats());
+  }
+
+private:
+  std::shared_ptr<ServerState> state_;
+  std::vector<std::unique_ptr<boost::asio::io_context>> ios_;
+  std::vector<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> guards_;
+  /// @brief the wheels are destroyed before their contexts
+  std::vector<std::unique_ptr<TimerWheel>> wheels_;
   boost::asio::ip::tcp::endpoint protocol_;
-  std::shared_ptr<Listener> listener_;
+  std::vector<std::shared_ptr<Listener>> listeners_;
   std::uint16_t countThr_;
-  std::atomic<bool> exit_;
-  boost::thread_group threads_;
-  static constexpr std::chrono::milliseconds waitMs_{60};
+  bool started_{false};
+  std::vector<std::thread> threads_;
+  /// @brief interval of the check of the requests in flight on the drain
+  static constexpr std::chrono::milliseconds drainMs_{5};
 };
 
 HttpServer::HttpServer(const std::string_view address, std::uint16_t port, std::uint16_t threads)
-: impl_(std::make_unique<Impl>(address, port, threads))
+: impl_(std::make_unique<Impl>(address, port, threads, Configuration{}))
+{
+}
+
+HttpServer::HttpServer(const std::string_view address, std::uint16_t port, std::uint16_t threads, const Configuration& config)
+: impl_(std::make_unique<Impl>(address, port, threads, config))
 {
 }
 
@@ -227,13 +561,84 @@ void HttpServer::Stop()
   impl_->Stop();
 }
 
+ServerStats HttpServer::GetStats() const
+{
+  return impl_->GetStats();
+}
+
+std::string HttpServer::GetMetrics() const
+{
+  return impl_->GetMetrics();
+}
+
+Configuration::IoBackend HttpServer::GetIoBackend() noexcept
+{
+  // asio replaces the reactor by io_uring only without epoll
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+  return Configuration::IoBackend::io_uring;
+#else
+  return Configuration::IoBackend::epoll;
+#endif
+}
+
 HttpServer::~HttpServer()
 {
 }
 
-void HttpServer::AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler)
+void HttpServer::AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler,
+    const RouteOptions& options)
+{
+  impl_->AddRequestHandler(uri, method, handler, options);
+}
+
+void HttpServer::AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RouteRequestHandler handler,
+    const RouteOptions& options)
+{
+  impl_->AddRequestHandler(uri, method, handler, options);
+}
+
+void HttpServer::AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, AsyncRequestHandler handler,
+    const RouteOptions& options)
+{
+  impl_->AddRequestHandler(uri, method, handler, options);
+}
+
+void HttpServer::AddRequestHandler(const std::string_view uri, boost::beast::http::verb method, RequestHandler handler,
+    std::shared_ptr<thread::PoolThread> pool, const RouteOptions& options)
+{
+  impl_->AddRequestHandler(uri, method, handler, pool, options);
+}
+
+void HttpServer::AddStreamRequestHandler(const std::string_view uri, boost::beast::http::verb method, StreamRequestHandler handler,
+    const RouteOptions& options)
+{
+  impl_->AddStreamRequestHandler(uri, method, handler, options);
+}
+
+void HttpServer::AddStreamResponseHandler(const std::string_view uri, boost::beast::http::verb method, StreamResponseHandler handler,
+    const RouteOptions& options)
+{
+  impl_->AddStreamResponseHandler(uri, method, handler, options);
+}
+
+void HttpServer::AddResponse(const std::string_view uri, boost::beast::http::verb method, ResponseTemplatePtr response)
+{
+  impl_->AddResponse(uri, method, std::move(response));
+}
+
+void HttpServer::AddStaticFiles(const std::string_view uri, const filesystem::path& root, const StaticFilesOptions& options)
+{
+  impl_->AddStaticFiles(uri, root, options);
+}
+
+void HttpServer::AddEventStreamHandler(const std::string_view uri, EventStreamHandler handler, const EventStreamOptions& options)
+{
+  impl_->AddEventStreamHandler(uri, std::move(handler), options);
+}
+
+void HttpServer::AddWebSocketHandler(const std::string_view uri, WebSocketHandler handler, const WebSocketOptions& options)
 {
-  impl_->AddRequestHandler(uri, method, handler);
+  impl_->AddWebSocketHandler(uri, std::move(handler), options);
 }
 
 }
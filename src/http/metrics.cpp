@@ -0,0 +1,316 @@
+//! @file metrics.cpp
+//! @brief The implementation metrics of the routes of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+// this
+#include <cmntype/http/metrics.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace
+{
+/// @brief Index of the shard of the current thread
+std::size_t ShardIndex(std::size_t count) noexcept
+{
+  static std::atomic<std::size_t> next{0};
+  thread_local const std::size_t index = next.fetch_add(1, std::memory_order_relaxed);
+  return index % count;
+}
+
+std::size_t HighBit(std::uint64_t value) noexcept
+{
+  std::size_t bit = 0;
+  while (value >>= 1)
+  {
+    bit++;
+  }
+  return bit;
+}
+
+/// @brief Escape the value of the label
+std::string Escape(std::string_view value)
+{
+  std::string result;
+  result.reserve(value.size());
+  for (const auto c : value)
+  {
+    switch (c)
+    {
+      case '\\': result += "\\\\"; break;
+      case '"': result += "\\\""; break;
+      case '\n': result += "\\n"; break;
+      default: result += c;
+    }
+  }
+  return result;
+}
+
+double Seconds(std::uint64_t microseconds)
+{
+  return static_cast<double>(microseconds) / 1e6;
+}
+}  // namespace
+
+std::size_t Histogram::Index(std::uint64_t value) noexcept
+{
+  if (value < subCount)
+  {
+    return static_cast<std::size_t>(value);
+  }
+
+  const auto bit = HighBit(value);
+  const auto index = (bit - subBits + 1) * subCount + static_cast<std::size_t>((value >> (bit - subBits)) & (subCount - 1));
+  return std::min(index, size - 1);
+}
+
+std::uint64_t Histogram::Upper(std::size_t index) noexcept
+{
+  if (index < subCount)
+  {
+    return index + 1;
+  }
+
+  const auto block = index / subCount;
+  const auto sub = index % subCount;
+  return static_cast<std::uint64_t>(subCount + sub + 1) << (block - 1);
+}
+
+void Histogram::Add(std::size_t index, std::uint64_t count) noexcept
+{
+  counts_[std::min(index, size - 1)] += count;
+  count_ += count;
+}
+
+void Histogram::Merge(const Histogram& other) noexcept
+{
+  for (std::size_t i = 0; i < size; i++)
+  {
+    counts_[i] += other.counts_[i];
+  }
+  count_ += other.count_;
+}
+
+std::uint64_t Histogram::Quantile(double q) const noexcept
+{
+  if (!count_)
+  {
+    return 0;
+  }
+
+  const auto rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * count_)), 1);
+
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < size; i++)
+  {
+    total += counts_[i];
+    if (total >= rank)
+    {
+      const auto lower = i ? Upper(i - 1) : 0;
+      return lower + (Upper(i) - 1 - lower) / 2;
+    }
+  }
+  return Upper(size - 1);
+}
+
+RouteMetrics::RouteMetrics(std::string route, std::string method)
+: route_{std::move(route)}
+, method_{std::move(method)}
+{
+}
+
+void RouteMetrics::Record(unsigned status, std::chrono::steady_clock::duration latency, std::uint64_t bytesIn,
+    std::uint64_t bytesOut) noexcept
+{
+  auto& shard = shards_[ShardIndex(shards_.size())];
+
+  const auto microseconds = static_cast<std::uint64_t>(
+      std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(latency).count(), 0));
+
+  shard.latency[Histogram::Index(microseconds)].fetch_add(1, std::memory_order_relaxed);
+  shard.sum.fetch_add(microseconds, std::memory_order_relaxed);
+  shard.bytesIn.fetch_add(bytesIn, std::memory_order_relaxed);
+  shard.bytesOut.fetch_add(bytesOut, std::memory_order_relaxed);
+
+  if (status < minStatus_ || status >= maxStatus_)
+  {
+    return;
+  }
+
+  // the threads of the same shard may claim the free slot at once, the loser checks the status of the winner
+  for (auto& slot : shard.statuses)
+  {
+    auto current = slot.status.load(std::memory_order_acquire);
+    if (!current && slot.status.compare_exchange_strong(current, status, std::memory_order_acq_rel))
+    {
+      current = status;
+    }
+
+    if (current == status)
+    {
+      slot.count.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  shard.classes[status / 100 - 1].fetch_add(1, std::memory_order_relaxed);
+}
+
+RouteMetrics::Snapshot RouteMetrics::Get() const
+{
+  Snapshot snapshot;
+
+  for (const auto& shard : shards_)
+  {
+    for (std::size_t i = 0; i < Histogram::size; i++)
+    {
+      if (const auto count = shard.latency[i].load(std::memory_order_relaxed))
+      {
+        snapshot.latency.Add(i, count);
+      }
+    }
+
+    snapshot.sum += std::chrono::microseconds{shard.sum.load(std::memory_order_relaxed)};
+    snapshot.bytesIn += shard.bytesIn.load(std::memory_order_relaxed);
+    snapshot.bytesOut += shard.bytesOut.load(std::memory_order_relaxed);
+
+    for (const auto& slot : shard.statuses)
+    {
+      const auto status = slot.status.load(std::memory_order_acquire);
+      const auto count = slot.count.load(std::memory_order_relaxed);
+      if (status && count)
+      {
+        snapshot.statuses[status] += count;
+      }
+    }
+
+    for (std::size_t i = 0; i < shard.classes.size(); i++)
+    {
+      snapshot.classes[i] += shard.classes[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  return snapshot;
+}
+
+Metrics::Metrics()
+: unmatched_{std::make_shared<RouteMetrics>("unmatched", "*")}
+{
+}
+
+std::shared_ptr<RouteMetrics> Metrics::Route(std::string_view route, boost::beast::http::verb method)
+{
+  const auto name = boost::beast::http::to_string(method);
+
+  std::lock_guard<std::mutex> lock{m_};
+
+  const auto it = std::find_if(routes_.begin(), routes_.end(), [route, name](const auto& metrics)
+      {
+        return metrics->Route() == route && metrics->Method() == std::string_view{name.data(), name.size()};
+      });
+  if (it != routes_.end())
+  {
+    return *it;
+  }
+
+  routes_.push_back(std::make_shared<RouteMetrics>(std::string(route), std::string(name)));
+  return routes_.back();
+}
+
+std::string Metrics::Format(const ServerStats& stats) const
+{
+  std::vector<std::shared_ptr<RouteMetrics>> routes;
+  {
+    std::lock_guard<std::mutex> lock{m_};
+    routes = routes_;
+  }
+  routes.push_back(unmatched_);
+
+  std::vector<std::pair<std::string, RouteMetrics::Snapshot>> snapshots;
+  snapshots.reserve(routes.size());
+  for (const auto& route : routes)
+  {
+    auto snapshot = route->Get();
+    if (snapshot.latency.Count())
+    {
+      snapshots.emplace_back("route=\"" + Escape(route->Route()) + "\",method=\"" + Escape(route->Method()) + "\"",
+          std::move(snapshot));
+    }
+  }
+
+  std::ostringstream out;
+
+  out << "# HELP http_requests_total Count of the completed requests.\n"
+      << "# TYPE http_requests_total counter\n";
+  for (const auto& [labels, snapshot] : snapshots)
+  {
+    for (const auto& [status, count] : snapshot.statuses)
+    {
+      out << "http_requests_total{" << labels << ",code=\"" << status << "\"} " << count << '\n';
+    }
+    for (std::size_t i = 0; i < snapshot.classes.size(); i++)
+    {
+      if (snapshot.classes[i])
+      {
+        out << "http_requests_total{" << labels << ",code=\"" << i + 1 << "xx\"} " << snapshot.classes[i] << '\n';
+      }
+    }
+  }
+
+  out << "# HELP http_request_duration_seconds Latency from the request header to the written response.\n"
+      << "# TYPE http_request_duration_seconds summary\n";
+  for (const auto& [labels, snapshot] : snapshots)
+  {
+    for (const auto q : {0.5, 0.9, 0.99, 0.999})
+    {
+      out << "http_request_duration_seconds{" << labels << ",quantile=\"" << q << "\"} "
+          << Seconds(snapshot.latency.Quantile(q)) << '\n';
+    }
+    out << "http_request_duration_seconds_sum{" << labels << "} " << Seconds(static_cast<std::uint64_t>(snapshot.sum.count())) << '\n'
+        << "http_request_duration_seconds_count{" << labels << "} " << snapshot.latency.Count() << '\n';
+  }
+
+  out << "# HELP http_request_bytes_total Size of the requests.\n"
+      << "# TYPE http_request_bytes_total counter\n";
+  for (const auto& [labels, snapshot] : snapshots)
+  {
+    out << "http_request_bytes_total{" << labels << "} " << snapshot.bytesIn << '\n';
+  }
+
+  out << "# HELP http_response_bytes_total Size of the responses.\n"
+      << "# TYPE http_response_bytes_total counter\n";
+  for (const auto& [labels, snapshot] : snapshots)
+  {
+    out << "http_response_bytes_total{" << labels << "} " << snapshot.bytesOut << '\n';
+  }
+
+  out << "# HELP http_connections Open connections.\n"
+      << "# TYPE http_connections gauge\n"
+      << "http_connections " << stats.connections << '\n'
+      << "# HELP http_requests_in_flight Requests waiting for the response.\n"
+      << "# TYPE http_requests_in_flight gauge\n"
+      << "http_requests_in_flight " << stats.requests << '\n'
+      << "# HELP http_rejected_connections_total Connections rejected by the limit.\n"
+      << "# TYPE http_rejected_connections_total counter\n"
+      << "http_rejected_connections_total " << stats.rejectedConnections << '\n'
+      << "# HELP http_paused_accepts_total Pauses of the accept by the limit.\n"
+      << "# TYPE http_paused_accepts_total counter\n"
+      << "http_paused_accepts_total " << stats.pausedAccepts << '\n'
+      << "# HELP http_rejected_requests_total Requests rejected by the limit.\n"
+      << "# TYPE http_rejected_requests_total counter\n"
+      << "http_rejected_requests_total " << stats.rejectedRequests << '\n';
+
+  return out.str();
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,161 @@
+//! @file rate_limiter.cpp
+//! @brief The implementation rate limiter of the clients of the route
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <functional>
+#include <string_view>
+
+// this
+#include <cmntype/http/rate_limiter.h>
+
+namespace common
+{
+namespace http
+{
+namespace
+{
+std::size_t ShardCount(std::size_t clients, std::size_t slots)
+{
+  std::size_t count = 1;
+  while (count * slots < clients)
+  {
+    count <<= 1;
+  }
+  return count;
+}
+
+/// @brief Hash of the key, 0 is reserved for the free slot
+std::uint64_t Hash(std::string_view key, std::uint64_t seed) noexcept
+{
+  const auto hash = static_cast<std::uint64_t>(std::hash<std::string_view>{}(key)) * 0x9e3779b97f4a7c15ull + seed;
+  return hash ? hash : 1;
+}
+}  // namespace
+
+RateLimiter::RateLimiter(const RateLimitOptions& options)
+: interval_{std::max<Clock::rep>(
+      std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / std::max(options.rate, 1e-6))).count(), 1)}
+, tolerance_{interval_ * static_cast<Clock::rep>(std::max<std::size_t>(options.burst, 1))}
+, header_{options.header}
+, shards_(ShardCount(options.clients, slotCount_))
+{
+}
+
+std::uint64_t RateLimiter::Key(const HttpRequestHeader& header) const
+{
+  if (header_.empty())
+  {
+    return 0;
+  }
+
+  const auto value = header[header_];
+  if (value.empty())
+  {
+    return 0;
+  }
+
+  // the seed separates the values of the header from the addresses
+  return Hash(std::string_view{value.data(), value.size()}, 1);
+}
+
+std::uint64_t RateLimiter::Key(const boost::asio::ip::address& address) const noexcept
+{
+  if (address.is_v4())
+  {
+    const auto bytes = address.to_v4().to_bytes();
+    return Hash(std::string_view{reinterpret_cast<const char*>(bytes.data()), bytes.size()}, 0);
+  }
+
+  const auto bytes = address.to_v6().to_bytes();
+  return Hash(std::string_view{reinterpret_cast<const char*>(bytes.data()), bytes.size()}, 0);
+}
+
+RateLimiter::Clock::duration RateLimiter::Acquire(std::uint64_t key, Clock::time_point now) noexcept
+{
+  const auto time = now.time_since_epoch().count();
+  auto& shard = shards_[key & (shards_.size() - 1)];
+
+  for (;;)
+  {
+    Slot* victim = nullptr;
+    auto victimKey = std::uint64_t{0};
+    auto victimTat = Clock::rep{0};
+
+    for (auto& slot : shard.slots)
+    {
+      const auto current = slot.key.load(std::memory_order_acquire);
+      if (current == key)
+      {
+        return Take(slot, time);
+      }
+
+      // the free slot and the full bucket are taken first, otherwise the bucket closest to the full one
+      const auto tat = current ? slot.tat.load(std::memory_order_relaxed) : Clock::rep{0};
+      if (!victim || tat < victimTat)
+      {
+        victim = &slot;
+        victimKey = current;
+        victimTat = tat;
+      }
+    }
+
+    if (victim->key.compare_exchange_strong(victimKey, key, std::memory_order_acq_rel))
+    {
+      // the evicted client loses its bucket, the new one starts with the full bucket
+      victim->tat.store(0, std::memory_order_relaxed);
+      return Take(*victim, time);
+    }
+    // the slot is taken by the concurrent client, the shard is searched again
+  }
+}
+
+RateLimiter::Clock::duration RateLimiter::Acquire(const HttpRequestHeader& header, const boost::asio::ip::address& address,
+    Clock::time_point now)
+{
+  if (const auto wait = Acquire(Key(address), now); wait.count())
+  {
+    return wait;
+  }
+
+  const auto key = Key(header);
+  return key ? Acquire(key, now) : Clock::duration::zero();
+}
+
+std::size_t RateLimiter::Size() const noexcept
+{
+  std::size_t size = 0;
+  for (const auto& shard : shards_)
+  {
+    size += std::count_if(shard.slots.begin(), shard.slots.end(), [](const Slot& slot)
+        {
+          return slot.key.load(std::memory_order_relaxed) != 0;
+        });
+  }
+  return size;
+}
+
+RateLimiter::Clock::duration RateLimiter::Take(Slot& slot, Clock::rep now) noexcept
+{
+  auto tat = slot.tat.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    const auto next = std::max(tat, now) + interval_;
+    if (next - now > tolerance_)
+    {
+      rejected_.fetch_add(1, std::memory_order_relaxed);
+      return Clock::duration{next - now - tolerance_};
+    }
+
+    if (slot.tat.compare_exchange_weak(tat, next, std::memory_order_relaxed))
+    {
+      return Clock::duration::zero();
+    }
+  }
+}
+
+}  // namespace http
+}  // namespace common
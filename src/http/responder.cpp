@@ -0,0 +1,31 @@
+//! @file responder.cpp
+//! @brief The implementation completion of the asynchronous request handler
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// this
+#include <cmntype/http/responder.h>
+
+namespace common
+{
+namespace http
+{
+
+Responder::Responder(std::shared_ptr<Sink> sink)
+: sink_{std::move(sink)}
+{
+}
+
+void Responder::operator()(HttpResponse&& response) const
+{
+  sink_->Send(std::move(response));
+}
+
+void Responder::operator()(SharedResponse&& response) const
+{
+  sink_->Send(std::move(response));
+}
+
+}  // namespace http
+}  // namespace common
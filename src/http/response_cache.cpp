@@ -0,0 +1,148 @@
+//! @file response_cache.cpp
+//! @brief The implementation cache of the responses of the route
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <functional>
+
+// openssl
+#include <openssl/evp.h>
+
+// this
+#include <cmntype/http/response_cache.h>
+#include <cmntype/http/http_response.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+/// @brief The strong validator of the body: the hex of the first 128 bits of SHA-256,
+/// it is the same in all processes of the server
+std::string MakeETag(const std::string& body)
+{
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  unsigned int size = 0;
+  EVP_Digest(body.data(), body.size(), digest, &size, EVP_sha256(), nullptr);
+
+  static constexpr char hex[] = "0123456789abcdef";
+  std::string etag{"\""};
+  for (unsigned int i = 0; i < std::min(size, 16u); i++)
+  {
+    etag.push_back(hex[digest[i] >> 4]);
+    etag.push_back(hex[digest[i] & 0x0f]);
+  }
+  etag.push_back('"');
+  return etag;
+}
+}  // namespace
+
+ResponseCache::ResponseCache(const CacheOptions& options)
+: options_{options}
+{
+}
+
+std::string ResponseCache::Key(const HttpRequest& request) const
+{
+  return MakeRequestKey(request, options_.vary);
+}
+
+ResponseCache::ResponsePtr ResponseCache::Find(const std::string& key)
+{
+  auto& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock{shard.m};
+
+  auto it = shard.entries.find(key);
+  if (it == shard.entries.end())
+  {
+    return nullptr;
+  }
+
+  if (it->second.expires <= Clock::now())
+  {
+    Erase(shard, it);
+    return nullptr;
+  }
+
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second.lru);
+  return it->second.response;
+}
+
+bool ResponseCache::Store(const std::string& key, HttpResponse& response)
+{
+  // the response of the client (the cookie, the private data) isn't shared with the other clients
+  const auto control = response[beast_http::field::cache_control];
+  if (response.result() != beast_http::status::ok || control.find("no-store") != boost::beast::string_view::npos ||
+      control.find("private") != boost::beast::string_view::npos || response.count(beast_http::field::set_cookie))
+  {
+    return false;
+  }
+
+  if (!response.count(beast_http::field::etag))
+  {
+    response.set(beast_http::field::etag, MakeETag(response.body()));
+  }
+
+  const auto size = response.body().size() + key.size();
+  const auto limit = options_.maxSize / shardCount_;
+  if (size > limit)
+  {
+    return false;
+  }
+
+  auto cached = std::make_shared<const HttpResponse>(response);
+  const auto expires = Clock::now() + options_.ttl;
+
+  auto& shard = GetShard(key);
+  std::lock_guard<std::mutex> lock{shard.m};
+
+  auto it = shard.entries.find(key);
+  if (it != shard.entries.end())
+  {
+    Erase(shard, it);
+  }
+
+  while (shard.size + size > limit && !shard.lru.empty())
+  {
+    Erase(shard, shard.entries.find(shard.lru.back()));
+  }
+
+  shard.lru.push_front(key);
+  shard.entries.emplace(key, Entry{std::move(cached), expires, shard.lru.begin()});
+  shard.size += size;
+
+  return true;
+}
+
+std::size_t ResponseCache::Size() const
+{
+  std::size_t size = 0;
+  for (const auto& shard : shards_)
+  {
+    std::lock_guard<std::mutex> lock{shard.m};
+    size += shard.entries.size();
+  }
+  return size;
+}
+
+ResponseCache::Shard& ResponseCache::GetShard(const std::string& key)
+{
+  return shards_[std::hash<std::string>{}(key) % shardCount_];
+}
+
+void ResponseCache::Erase(Shard& shard, std::unordered_map<std::string, Entry>::iterator it)
+{
+  shard.size -= it->second.response->body().size() + it->first.size();
+  shard.lru.erase(it->second.lru);
+  shard.entries.erase(it);
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,65 @@
+//! @file response_template.cpp
+//! @brief The implementation template of the constant response
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <sstream>
+
+// this
+#include <cmntype/http/http_response.h>
+#include <cmntype/http/response_template.h>
+
+namespace common
+{
+namespace http
+{
+
+ResponseTemplate::ResponseTemplate(boost::beast::http::status status, std::string_view contentType,
+    std::string_view encoding, std::string_view data)
+  : ResponseTemplate{MakeResponse(HttpRequest{}, status, contentType, encoding, data)}
+{
+}
+
+ResponseTemplate::ResponseTemplate(HttpResponse response)
+  : response_{std::move(response)}
+{
+  response_.prepare_payload();
+
+  for (const unsigned version : {10u, 11u})
+  {
+    for (const bool keepAlive : {false, true})
+    {
+      boost::beast::http::response<boost::beast::http::empty_body> header{response_.base()};
+      header.version(version);
+      header.keep_alive(keepAlive);
+
+      std::ostringstream os;
+      os << header.base();
+      headers_[Index(version, keepAlive)] = os.str();
+    }
+  }
+}
+
+boost::asio::const_buffer ResponseTemplate::Header(unsigned version, bool keepAlive) const noexcept
+{
+  return boost::asio::buffer(headers_[Index(version, keepAlive)]);
+}
+
+HttpResponse ResponseTemplate::Make(const HttpRequest& request) const
+{
+  auto response = response_;
+  response.version(request.version());
+  response.keep_alive(request.keep_alive());
+  return response;
+}
+
+ResponseTemplatePtr MakeResponseTemplate(boost::beast::http::status status, std::string_view contentType,
+    std::string_view encoding, std::string_view data)
+{
+  return std::make_shared<const ResponseTemplate>(status, contentType, encoding, data);
+}
+
+}  // namespace http
+}  // namespace common
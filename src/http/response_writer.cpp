@@ -0,0 +1,36 @@
+//! @file response_writer.cpp
+//! @brief The implementation writer of the streamed (chunked) response
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// this
+#include <cmntype/http/response_writer.h>
+
+namespace common
+{
+namespace http
+{
+
+ResponseWriter::ResponseWriter(std::shared_ptr<Sink> sink)
+: sink_{std::move(sink)}
+{
+}
+
+void ResponseWriter::Begin(HttpResponseHeader&& header) const
+{
+  sink_->Begin(std::move(header));
+}
+
+void ResponseWriter::Write(std::string chunk, WriteHandler handler) const
+{
+  sink_->Write(std::move(chunk), std::move(handler));
+}
+
+void ResponseWriter::End() const
+{
+  sink_->End();
+}
+
+}  // namespace http
+}  // namespace common
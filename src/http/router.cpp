@@ -0,0 +1,275 @@
+//! @file router.cpp
+//! @brief The implementation radix tree router
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+#include <limits>
+
+// this
+#include <cmntype/http/router.h>
+#include <cmntype/error/error.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace
+{
+constexpr std::string_view PrefixParam{"*"};
+
+std::size_t CommonPrefix(std::string_view lhs, std::string_view rhs)
+{
+  const auto count = std::min(lhs.size(), rhs.size());
+  std::size_t i = 0;
+  for (; i < count && lhs[i] == rhs[i]; ++i)
+  {
+  }
+  return i;
+}
+}  // namespace
+
+Router::Router()
+: nodes_(1)
+{
+}
+
+void Router::Add(std::string_view uri, Context context)
+{
+  if (uri.empty() || uri.front() != '/')
+  {
+    THROW_COMMON_ERROR("Route '" + std::string(uri) + "' must start with '/'");
+  }
+
+  Index index = 0;
+  bool prefix = false;
+  std::size_t params = 0;
+
+  auto path = uri;
+  while (!path.empty())
+  {
+    const auto label = path.substr(0, path.find_first_of("{*"));
+    index = InsertStatic(index, label);
+    path.remove_prefix(label.size());
+
+    if (path.empty())
+    {
+      break;
+    }
+
+    if (path.front() == '*')
+    {
+      if (path.size() != 1)
+      {
+        THROW_COMMON_ERROR("Prefix route '" + std::string(uri) + "' must end with '*'");
+      }
+      prefix = true;
+      break;
+    }
+
+    const auto close = path.find('}');
+    if (close == std::string_view::npos || close == 1)
+    {
+      THROW_COMMON_ERROR("Invalid parameter in the route '" + std::string(uri) + "'");
+    }
+
+    const auto rest = path.substr(close + 1);
+    if (!rest.empty() && rest.front() != '/')
+    {
+      THROW_COMMON_ERROR("Parameter must occupy the whole segment in the route '" + std::string(uri) + "'");
+    }
+
+    if (++params >= MaxRouteParams)
+    {
+      THROW_COMMON_ERROR("Too many parameters in the route '" + std::string(uri) + "'");
+    }
+
+    index = InsertParam(index, path.substr(1, close - 1));
+    path = rest;
+  }
+
+  auto& node = nodes_[index];
+  auto& methods = prefix ? node.prefixMethods : node.methods;
+  auto& slot = methods[static_cast<std::size_t>(context.method)];
+
+  if (slot)
+  {
+    contexts_[slot - 1] = std::move(context);
+    return;
+  }
+
+  if (contexts_.size() >= std::numeric_limits<Methods::value_type>::max())
+  {
+    THROW_COMMON_ERROR("Too many routes");
+  }
+
+  contexts_.push_back(std::move(context));
+  slot = static_cast<Methods::value_type>(contexts_.size());
+  (prefix ? node.prefixEndpoint : node.endpoint) = true;
+}
+
+Router::Index Router::InsertStatic(Index index, std::string_view label)
+{
+  while (!label.empty())
+  {
+    const auto pos = nodes_[index].indices.find(label.front());
+
+    if (pos == std::string::npos)
+    {
+      const auto child = static_cast<Index>(nodes_.size());
+      nodes_.emplace_back();
+      nodes_[child].prefix = std::string(label);
+      nodes_[index].indices.push_back(label.front());
+      nodes_[index].children.push_back(child);
+      return child;
+    }
+
+    const auto child = nodes_[index].children[pos];
+    const auto common = CommonPrefix(nodes_[child].prefix, label);
+
+    if (common < nodes_[child].prefix.size())
+    {
+      // split the node, the tail of the label is moved to the new child
+      const auto tail = static_cast<Index>(nodes_.size());
+      nodes_.emplace_back();
+
+      auto& node = nodes_[child];
+      auto& split = nodes_[tail];
+
+      split.prefix = node.prefix.substr(common);
+      split.indices = std::move(node.indices);
+      split.children = std::move(node.children);
+      split.param = node.param;
+      split.methods = node.methods;
+      split.prefixMethods = node.prefixMethods;
+      split.endpoint = node.endpoint;
+      split.prefixEndpoint = node.prefixEndpoint;
+
+      node.prefix.resize(common);
+      node.indices.assign(1, split.prefix.front());
+      node.children.assign(1, tail);
+      node.param = npos;
+      node.methods = {};
+      node.prefixMethods = {};
+      node.endpoint = false;
+      node.prefixEndpoint = false;
+    }
+
+    index = child;
+    label.remove_prefix(common);
+  }
+
+  return index;
+}
+
+Router::Index Router::InsertParam(Index index, std::string_view name)
+{
+  const auto param = nodes_[index].param;
+
+  if (param != npos)
+  {
+    if (nodes_[param].name != name)
+    {
+      THROW_COMMON_ERROR("Conflict of the parameters '" + nodes_[param].name + "' and '" + std::string(name) + "'");
+    }
+    return param;
+  }
+
+  const auto child = static_cast<Index>(nodes_.size());
+  nodes_.emplace_back();
+  nodes_[child].name = std::string(name);
+  nodes_[index].param = child;
+
+  return child;
+}
+
+const Context* Router::MatchNode(Index index, std::string_view path, std::size_t verb, RouteParams& params,
+                                         bool& pathFound) const
+{
+  const auto& node = nodes_[index];
+
+  if (path.empty())
+  {
+    if (node.endpoint)
+    {
+      if (const auto* context = Get(node.methods, verb))
+      {
+        return context;
+      }
+      pathFound = true;
+    }
+  }
+  else
+  {
+    const auto pos = node.indices.find(path.front());
+    if (pos != std::string::npos)
+    {
+      const auto child = node.children[pos];
+      const auto& label = nodes_[child].prefix;
+      if (path.compare(0, label.size(), label) == 0)
+      {
+        if (const auto* found = MatchNode(child, path.substr(label.size()), verb, params, pathFound))
+        {
+          return found;
+        }
+      }
+    }
+
+    if (node.param != npos && params.size() < params.capacity())
+    {
+      const auto value = path.substr(0, path.find('/'));
+      if (!value.empty())
+      {
+        params.push_back(RouteParam{nodes_[node.param].name, value});
+        if (const auto* found = MatchNode(node.param, path.substr(value.size()), verb, params, pathFound))
+        {
+          return found;
+        }
+        params.pop_back();
+      }
+    }
+  }
+
+  if (node.prefixEndpoint && params.size() < params.capacity())
+  {
+    if (const auto* context = Get(node.prefixMethods, verb))
+    {
+      params.push_back(RouteParam{PrefixParam, path});
+      return context;
+    }
+    pathFound = true;
+  }
+
+  return nullptr;
+}
+
+const Context* Router::Get(const Methods& methods, std::size_t verb) const
+{
+  const auto slot = verb < methods.size() ? methods[verb] : 0;
+  return slot ? &contexts_[slot - 1] : nullptr;
+}
+
+Router::Match Router::Find(std::string_view target, boost::beast::http::verb method) const
+{
+  Match match;
+
+  const auto path = target.substr(0, target.find('?'));
+
+  // the route of the other method doesn't hide the less specific route of the method
+  bool pathFound = false;
+  match.context = MatchNode(0, path, static_cast<std::size_t>(method), match.params, pathFound);
+  match.methodNotAllowed = !match.context && pathFound;
+
+  return match;
+}
+
+std::size_t Router::Size() const noexcept
+{
+  return contexts_.size();
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,67 @@
+//! @file router_registry.cpp
+//! @brief The implementation registry of the immutable routers
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// this
+#include <cmntype/http/router_registry.h>
+
+namespace common
+{
+namespace http
+{
+
+RouterRegistry::Snapshot::Snapshot(std::shared_ptr<const RouterRegistry> registry)
+: registry_{std::move(registry)}
+, version_{registry_->Version()}
+{
+  router_ = registry_->Get();
+}
+
+const Router& RouterRegistry::Snapshot::Get()
+{
+  return *Pin();
+}
+
+const RouterRegistry::RouterPtr& RouterRegistry::Snapshot::Pin()
+{
+  const auto version = registry_->Version();
+
+  if (version != version_)
+  {
+    router_ = registry_->Get();
+    version_ = version;
+  }
+
+  return router_;
+}
+
+RouterRegistry::RouterRegistry()
+: router_{std::make_shared<const Router>()}
+{
+}
+
+void RouterRegistry::Add(std::string_view uri, Context context)
+{
+  std::lock_guard<std::mutex> lock{m_};
+
+  auto router = std::make_shared<Router>(*router_);
+  router->Add(uri, std::move(context));
+
+  std::atomic_store_explicit(&router_, RouterPtr{std::move(router)}, std::memory_order_release);
+  version_.fetch_add(1, std::memory_order_release);
+}
+
+RouterRegistry::RouterPtr RouterRegistry::Get() const
+{
+  return std::atomic_load_explicit(&router_, std::memory_order_acquire);
+}
+
+std::uint64_t RouterRegistry::Version() const noexcept
+{
+  return version_.load(std::memory_order_acquire);
+}
+
+}  // namespace http
+}  // namespace common
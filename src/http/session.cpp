@@ -5,8 +5,22 @@
 //! @date 17.06.2020
 //! @copyright (c) Bobrov Alexey
 
+// std
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <variant>
+
+// posix
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#elif !defined(_WIN32)
+#include <unistd.h>
+#endif
+
 #include <cmntype/http/session.h>
 #include <cmntype/http/http_response.h>
+#include <cmntype/http/websocket_session.h>
 #include <cmntype/logger/logger.h>
 #include <cmntype/common/stopwatch.h>
 
@@ -15,53 +29,697 @@ namespace common
 namespace http
 {
 
-Session::Dispatcher::Dispatcher(Session& self)
-: self_{self}
+class Session::FileWork final : public Work
+{
+public:
+  FileWork(Session& self, FileResponse&& response)
+    : self_{self}
+    , response_{std::move(response)}
+    , serializer_{response_.header}
+    , offset_{response_.offset}
+    , remain_{response_.size}
+  {
+  }
+
+  void operator()() override
+  {
+    boost::beast::http::async_write_header(self_.stream_, serializer_,
+        [self = self_.shared_from_this(), this](boost::beast::error_code ec, std::size_t bytesTransferred)
+        {
+          total_ += bytesTransferred;
+          if (ec)
+          {
+            return Finish(ec);
+          }
+          DoSend();
+        });
+  }
+
+private:
+  /// @brief maximum size of the one system call
+  static constexpr std::uint64_t maxChunk_{1024 * 1024};
+
+  void DoSend()
+  {
+#if defined(__linux__)
+    // the encrypted body is written from the user space
+    if (!self_.stream_.IsTls())
+    {
+      return DoSendFile();
+    }
+#endif
+#if !defined(_WIN32)
+    DoCopy();
+#else
+    Finish(boost::asio::error::operation_not_supported);
+#endif
+  }
+
+#if defined(__linux__)
+  void DoSendFile()
+  {
+    boost::beast::error_code ec;
+    auto& socket = self_.stream_.Socket();
+    socket.native_non_blocking(true, ec);
+
+    while (remain_ && !ec)
+    {
+      auto offset = static_cast<off_t>(offset_);
+      const auto result = ::sendfile(socket.native_handle(), response_.file->Handle(), &offset, std::min(remain_, maxChunk_));
+      if (result > 0)
+      {
+        offset_ += static_cast<std::uint64_t>(result);
+        remain_ -= static_cast<std::uint64_t>(result);
+        total_ += static_cast<std::size_t>(result);
+      }
+      else if (result == 0)
+      {
+        // the file is truncated after the header was sent
+        ec = boost::asio::error::eof;
+      }
+      else if (errno == EAGAIN || errno == EWOULDBLOCK)
+      {
+        // the write timeout is restarted by the progress
+        self_.UpdateTimer();
+        socket.async_wait(boost::asio::ip::tcp::socket::wait_write,
+            [self = self_.shared_from_this(), this](boost::beast::error_code ec)
+            {
+              if (ec)
+              {
+                return Finish(ec);
+              }
+              DoSendFile();
+            });
+        return;
+      }
+      else if (errno != EINTR)
+      {
+        ec.assign(errno, boost::system::system_category());
+      }
+    }
+
+    Finish(ec);
+  }
+#endif
+
+#if !defined(_WIN32)
+  void DoCopy()
+  {
+    if (remain_)
+    {
+      buffer_.resize(static_cast<std::size_t>(std::min(remain_, maxChunk_)));
+      const auto result = ::pread(response_.file->Handle(), buffer_.data(), buffer_.size(), static_cast<off_t>(offset_));
+      if (result <= 0)
+      {
+        return Finish(result == 0 ? boost::asio::error::eof : boost::beast::error_code{errno, boost::system::system_category()});
+      }
+
+      offset_ += static_cast<std::uint64_t>(result);
+      remain_ -= static_cast<std::uint64_t>(result);
+
+      self_.UpdateTimer();
+      boost::asio::async_write(self_.stream_, boost::asio::buffer(buffer_.data(), static_cast<std::size_t>(result)),
+          [self = self_.shared_from_this(), this](boost::beast::error_code ec, std::size_t bytesTransferred)
+          {
+            total_ += bytesTransferred;
+            if (ec)
+            {
+              return Finish(ec);
+            }
+            DoCopy();
+          });
+      return;
+    }
+
+    Finish({});
+  }
+#endif
+
+  void Finish(boost::beast::error_code ec)
+  {
+    // the work is destroyed by the session after the write is completed
+    auto& self = self_;
+    self.HandleWrite(response_.header.need_eof(), ec, total_);
+  }
+
+private:
+  Session& self_;
+  FileResponse response_;
+  boost::beast::http::response_serializer<boost::beast::http::empty_body> serializer_;
+  std::uint64_t offset_;
+  std::uint64_t remain_;
+  std::size_t total_{0};
+  std::vector<char> buffer_;
+};
+
+class Session::TemplateWork final : public Work
+{
+public:
+  TemplateWork(Session& self, Slot& slot, ResponseTemplatePtr&& response, bool keepAlive)
+    : self_{self}
+    , response_{std::move(response)}
+    , buffers_{response_->Header(slot.request.version(), keepAlive), response_->Body()}
+    , close_{!keepAlive}
+  {
+    if (slot.request.method() == boost::beast::http::verb::head)
+    {
+      buffers_[1] = boost::asio::const_buffer{};
+    }
+  }
+
+  void operator()() override
+  {
+    boost::asio::async_write(self_.stream_, buffers_,
+        self_.Bind(&Session::HandleWrite, close_));
+  }
+
+private:
+  Session& self_;
+  ResponseTemplatePtr response_;
+  std::array<boost::asio::const_buffer, 2> buffers_;
+  bool close_;
+};
+
+void Session::SendLambda::operator()(Slot& slot, HttpResponse&& response) const
+{
+  const auto* context = slot.match.context;
+
+  if (!slot.cacheKey.empty())
+  {
+    context->cache->Store(slot.cacheKey, response);
+    slot.cacheKey.clear();
+
+    const auto etag = response[boost::beast::http::field::etag];
+    if (IsNotModified(slot.request, std::string_view{etag.data(), etag.size()}))
+    {
+      response = MakeResponseForNotModified(slot.request, std::string_view{etag.data(), etag.size()});
+    }
+  }
+
+  self_.state_->compressor.Apply(slot.request, response, context && (context->options.cacheable || context->cache));
+
+  Write(slot, std::move(response));
+}
+
+void Session::SendLambda::operator()(Slot& slot, SharedResponse&& response) const
+{
+  const auto* context = slot.match.context;
+
+  if (!slot.cacheKey.empty())
+  {
+    // the cache keeps its own copy of the response
+    HttpResponse copy{std::move(response.base())};
+    copy.body().assign(static_cast<const char*>(response.body().data()), response.body().size());
+    return (*this)(slot, std::move(copy));
+  }
+
+  self_.state_->compressor.Apply(slot.request, response, context && (context->options.cacheable || context->cache));
+
+  Write(slot, std::move(response));
+}
+
+void Session::SendLambda::operator()(Slot& slot, FileResponse&& response) const
+{
+  slot.status = response.header.result_int();
+  if (self_.IsClosing(slot))
+  {
+    response.header.keep_alive(false);
+  }
+  slot.response = std::make_unique<FileWork>(self_, std::move(response));
+
+  self_.DoWrite();
+}
+
+void Session::SendLambda::operator()(Slot& slot, ResponseTemplatePtr&& response) const
+{
+  slot.status = response->Status();
+  const bool keepAlive = slot.request.keep_alive() && !self_.IsClosing(slot);
+  slot.response = std::make_unique<TemplateWork>(self_, slot, std::move(response), keepAlive);
+
+  self_.DoWrite();
+}
+
+Session::Reply::Reply(std::shared_ptr<Session> self, Slot& slot)
+: self_{std::move(self)}
+, slot_{slot}
+{
+}
+
+Session::Reply::~Reply()
+{
+  if (!sent_)
+  {
+    COMMON_LOG_ERROR() << "Asynchronous handler didn't send the response";
+    Send(MakeResponseForServerError(slot_.request, "application/json", "UTF-8", "no response"));
+  }
+}
+
+void Session::Reply::Send(HttpResponse&& response)
 {
+  Post(std::move(response));
 }
 
-void Session::Dispatcher::operator()(const HttpRequest& request) const
+void Session::Reply::Send(SharedResponse&& response)
 {
-  const auto& uri = request.target();
-  const auto& verb = request.method();
+  Post(std::move(response));
+}
+
+template <class Response>
+void Session::Reply::Post(Response&& response)
+{
+  if (sent_.exchange(true))
+  {
+    COMMON_LOG_WARNING() << "Response is already sent";
+    return;
+  }
+
+  boost::asio::post(self_->stream_.get_executor(), [self = self_, &slot = slot_, response = std::move(response)]() mutable
+      {
+        self->lambda_(slot, std::move(response));
+      });
+}
+
+class Session::Chunked final : public std::enable_shared_from_this<Chunked>
+{
+  class Work final : public Session::Work
+  {
+  public:
+    explicit Work(std::shared_ptr<Chunked> chunked)
+      : chunked_{std::move(chunked)}
+    {
+    }
+
+    void operator()() override
+    {
+      chunked_->Start();
+    }
+
+  private:
+    std::shared_ptr<Chunked> chunked_;
+  };
+
+  struct Chunk
+  {
+    std::string data;
+    ResponseWriter::WriteHandler handler;
+  };
+
+public:
+  Chunked(Session& self, Slot& slot)
+    : self_{self}
+    , slot_{slot}
+  {
+  }
+
+  void OnBegin(HttpResponseHeader&& header)
+  {
+    if (begun_ || done_)
+    {
+      COMMON_LOG_WARNING() << "Header of the response is already sent";
+      return;
+    }
+
+    begun_ = true;
+    head_ = slot_.request.method() == boost::beast::http::verb::head;
+    message_.base() = std::move(header);
+    slot_.status = message_.result_int();
+    message_.version(slot_.request.version());
+    message_.erase(boost::beast::http::field::content_length);
+
+    // the body of HTTP/1.0 response is completed by closing the connection
+    if (message_.version() >= 11)
+    {
+      message_.keep_alive(slot_.request.keep_alive() && !self_.IsClosing(slot_));
+      message_.chunked(true);
+    }
+    else
+    {
+      message_.keep_alive(false);
+    }
+
+    if (slot_.match.context && slot_.match.context->longLived)
+    {
+      // the stream isn't waited by the drain, the drain ends it.
+      // The stream begun by the drain is ended at once and waited as the request
+      self_.events_ = weak_from_this();
+      ended_ = self_.state_->draining.load(std::memory_order_relaxed);
+      if (ended_)
+      {
+        slot_.ticket = self_.state_->admission.HoldRequest();
+      }
+    }
+
+    serializer_.emplace(message_);
+    slot_.response = std::make_unique<Work>(shared_from_this());
+    self_.DoWrite();
+  }
+
+  void OnWrite(std::string&& data, ResponseWriter::WriteHandler&& handler)
+  {
+    if (!begun_ || ended_ || (done_ && !head_))
+    {
+      COMMON_LOG_WARNING() << "Chunk is written out of the response";
+      if (handler)
+      {
+        handler(boost::asio::error::operation_aborted);
+      }
+      return;
+    }
+
+    // the response to HEAD has no body, the chunk is completed without the write
+    if (data.empty() || head_)
+    {
+      if (handler)
+      {
+        handler({});
+      }
+      return;
+    }
+
+    pending_.push_back(Chunk{std::move(data), std::move(handler)});
+    Resume();
+  }
+
+  /// @brief End the long-lived stream by the drain, the drain waits for the write of the end
+  void Shutdown(Admission::Ticket&& ticket)
+  {
+    if (done_)
+    {
+      return;
+    }
+
+    slot_.ticket = std::move(ticket);
+    OnEnd(false);
+  }
+
+  void OnEnd(bool aborted)
+  {
+    if (ended_ || done_)
+    {
+      return;
+    }
+
+    if (!begun_)
+    {
+      COMMON_LOG_ERROR() << "Streaming handler didn't send the response";
+      done_ = true;
+      return self_.lambda_(slot_, MakeResponseForServerError(slot_.request, "application/json", "UTF-8", "no response"));
+    }
+
+    ended_ = true;
+    aborted_ = aborted;
+    Resume();
+  }
+
+private:
+  void Start()
+  {
+    active_ = true;
+    writing_ = true;
+    boost::beast::http::async_write_header(self_.stream_, *serializer_,
+        [self = self_.shared_from_this(), chunked = shared_from_this()](boost::beast::error_code ec, std::size_t bytesTransferred)
+        {
+          chunked->HandleWrite(ec, bytesTransferred);
+        });
+  }
+
+  void Resume()
+  {
+    if (active_ && !writing_ && !done_)
+    {
+      DoWrite();
+    }
+  }
+
+  void DoWrite()
+  {
+    if (head_)
+    {
+      // the header is written, the response doesn't wait for the end of the producer
+      return Finish(message_.need_eof(), {});
+    }
+
+    if (!pending_.empty())
+    {
+      writing_ = true;
+      self_.UpdateTimer();
+      const auto handler = [self = self_.shared_from_this(), chunked = shared_from_this()](boost::beast::error_code ec, std::size_t bytesTransferred)
+          {
+            chunked->HandleChunk(ec, bytesTransferred);
+          };
+
+      const auto buffer = boost::asio::buffer(pending_.front().data);
+      if (message_.chunked())
+      {
+        boost::asio::async_write(self_.stream_, boost::beast::http::make_chunk(buffer), handler);
+      }
+      else
+      {
+        boost::asio::async_write(self_.stream_, buffer, handler);
+      }
+      return;
+    }
+
+    if (!ended_)
+    {
+      // the producer of the chunks isn't limited by the write timeout
+      TimerWheel::Disarm(self_);
+      return;
+    }
+
+    if (aborted_ || !message_.chunked())
+    {
+      // the incomplete body is signalled to the client by the closed connection
+      return Finish(aborted_ || message_.need_eof(), {});
+    }
+
+    writing_ = true;
+    last_ = true;
+    boost::asio::async_write(self_.stream_, boost::beast::http::make_chunk_last(),
+        [self = self_.shared_from_this(), chunked = shared_from_this()](boost::beast::error_code ec, std::size_t bytesTransferred)
+        {
+          chunked->HandleWrite(ec, bytesTransferred);
+        });
+  }
 
-  COMMON_LOG_TRACE() << "Search handlers for uri '" << uri << "', method '" << verb << "' (total count of handlers: " << self_.handlers_.size() << ")";
+  void HandleChunk(boost::beast::error_code ec, std::size_t bytesTransferred)
+  {
+    auto chunk = std::move(pending_.front());
+    pending_.pop_front();
 
-  auto handlersUri = self_.handlers_.equal_range(std::string(uri));
+    if (chunk.handler)
+    {
+      chunk.handler(ec);
+    }
 
-  RequestHandler handler;
+    HandleWrite(ec, bytesTransferred);
+  }
 
-  if (std::cend(self_.handlers_) != handlersUri.first)
+  void HandleWrite(boost::beast::error_code ec, std::size_t bytesTransferred)
   {
-    for (auto it = handlersUri.first; it != handlersUri.second; ++it)
+    writing_ = false;
+    total_ += bytesTransferred;
+
+    if (ec)
     {
-      if (it->second.method == verb)
+      return Finish(true, ec);
+    }
+
+    if (last_)
+    {
+      return Finish(message_.need_eof(), {});
+    }
+
+    DoWrite();
+  }
+
+  void Finish(bool close, boost::beast::error_code ec)
+  {
+    done_ = true;
+
+    for (auto& chunk : pending_)
+    {
+      if (chunk.handler)
       {
-        handler = it->second.handler;
+        chunk.handler(ec ? ec : boost::asio::error::operation_aborted);
       }
     }
+    pending_.clear();
+
+    // the work is destroyed by the session after the write is completed
+    self_.HandleWrite(close, ec, total_);
+  }
+
+private:
+  Session& self_;
+  Slot& slot_;
+  boost::beast::http::response<boost::beast::http::empty_body> message_;
+  std::optional<boost::beast::http::response_serializer<boost::beast::http::empty_body>> serializer_;
+  std::deque<Chunk> pending_;
+  std::size_t total_{0};
+  bool begun_{false};
+  bool ended_{false};
+  bool aborted_{false};
+  bool active_{false};
+  bool writing_{false};
+  bool last_{false};
+  bool done_{false};
+  bool head_{false};
+};
+
+Session::Writer::Writer(std::shared_ptr<Session> self, Slot& slot)
+: self_{std::move(self)}
+, chunked_{MakeShared<Chunked>(*self_, slot)}
+{
+}
+
+Session::Writer::~Writer()
+{
+  if (!ended_)
+  {
+    COMMON_LOG_WARNING() << "Streamed response is aborted";
+    boost::asio::post(self_->stream_.get_executor(), [self = self_, chunked = chunked_]
+        {
+          chunked->OnEnd(true);
+        });
+  }
+}
+
+void Session::Writer::Begin(HttpResponseHeader&& header)
+{
+  boost::asio::post(self_->stream_.get_executor(), [self = self_, chunked = chunked_, header = std::move(header)]() mutable
+      {
+        chunked->OnBegin(std::move(header));
+      });
+}
+
+void Session::Writer::Write(std::string&& chunk, ResponseWriter::WriteHandler&& handler)
+{
+  boost::asio::post(self_->stream_.get_executor(),
+      [self = self_, chunked = chunked_, chunk = std::move(chunk), handler = std::move(handler)]() mutable
+      {
+        chunked->OnWrite(std::move(chunk), std::move(handler));
+      });
+}
+
+void Session::Writer::End()
+{
+  if (ended_.exchange(true))
+  {
+    return;
   }
 
-  if (handler)
+  boost::asio::post(self_->stream_.get_executor(), [self = self_, chunked = chunked_]
+      {
+        chunked->OnEnd(false);
+      });
+}
+
+class Session::UpgradeWork final : public Work
+{
+public:
+  UpgradeWork(Session& self, Slot& slot)
+    : self_{self}
+    , slot_{slot}
+  {
+  }
+
+  void operator()() override
+  {
+    // the http session is finished, it is destroyed with the last handler
+    TimerWheel::Disarm(self_);
+    self_.Record(slot_, 0);
+    self_.upgraded_ = true;
+    // the WebSocket connection isn't a request in flight, it is closed by the drain
+    slot_.ticket.Reset();
+
+    auto session = std::make_shared<WebSocketSession>(std::move(self_.stream_), self_.state_, std::move(self_.connection_),
+        slot_.match.context->webSocket);
+    self_.state_->connections.Add(session);
+    session->Run(std::move(slot_.request));
+  }
+
+private:
+  Session& self_;
+  Slot& slot_;
+};
+
+Session::Dispatcher::Dispatcher(Session& self)
+: self_{self}
+{
+}
+
+void Session::Dispatcher::operator()(Slot& slot) const
+{
+  const auto& request = slot.request;
+  const auto uri = request.target();
+  const auto verb = request.method();
+
+  const auto& match = slot.match;
+
+  if (match.context && match.context->response)
+  {
+    self_.lambda_(slot, ResponseTemplatePtr{match.context->response});
+  }
+  else if (match.context && match.context->cache && self_.FromCache(slot))
+  {
+    COMMON_LOG_TRACE() << "Response is served from the cache";
+  }
+  else if (match.context && match.context->coalescer && self_.Coalesce(slot))
+  {
+    COMMON_LOG_TRACE() << "Request is coalesced";
+  }
+  else if (match.context && match.context->asyncHandler)
+  {
+    COMMON_LOG_TRACE() << "Dispatch request to the asynchronous handler";
+    match.context->asyncHandler(request, Responder{MakeShared<Reply>(self_.shared_from_this(), slot)});
+  }
+  else if (match.context && match.context->streamResponseHandler)
+  {
+    COMMON_LOG_TRACE() << "Dispatch request to the streaming handler of the response";
+    match.context->streamResponseHandler(request, ResponseWriter{MakeShared<Writer>(self_.shared_from_this(), slot)});
+  }
+  else if (match.context && match.context->files)
+  {
+    // the static files are routed by the prefix, the path is the parameter '*'
+    const auto path = match.params.empty() ? std::string_view{} : match.params.back().value;
+    std::visit([this, &slot](auto&& response) { self_.lambda_(slot, std::move(response)); },
+        match.context->files->Serve(request, path));
+  }
+  else if (match.context)
   {
     Stopwatch watch;
-    auto response = handler(request);
+    auto response = match.context->routeHandler ? match.context->routeHandler(request, match.params) : match.context->handler(request);
     COMMON_LOG_TRACE() << "Request processing completed "  << (watch.Get() * 1000.0) << " ms";
-    self_.lambda_(std::move(response));
+    self_.lambda_(slot, std::move(response));
+  }
+  else if (match.methodNotAllowed)
+  {
+    COMMON_LOG_WARNING() << "Not allowed method '" << verb << "' for uri '" << uri << "'";
+    self_.lambda_(slot, ResponseTemplatePtr{self_.state_->notAllowed});
   }
   else
   {
     COMMON_LOG_WARNING() << "Not found handler for uri '" << uri << "', method '" << verb << "'";
-    auto response = MakeResponseForNotFound(request, "application/json", "UTF-8", "not found");
-    self_.lambda_(std::move(response));  
+    self_.lambda_(slot, ResponseTemplatePtr{self_.state_->notFound});
   }
   
   COMMON_LOG_TRACE() << "Complete dispatch request";
 }
 
-Session::Session(boost::asio::ip::tcp::socket&& socket, const Handlers& handlers)
-  : stream_{std::move(socket)}
-  , handlers_{handlers}
+Session::Session(ConnectionSocket&& socket, std::shared_ptr<ServerState> state, Admission::Ticket connection,
+    TimerWheel& wheel)
+  : state_{std::move(state)}
+  , connection_{std::move(connection)}
+  , stream_{std::move(socket), state_->tls.get()}
+  , executor_{stream_.get_executor()}
+  , queue_(std::max<std::size_t>(state_->config.pipelineLimit, 1))
+  , pipelineLimit_{queue_.capacity()}
+  , bodyLimit_{state_->config.bodyLimit}
+  , wheel_{wheel}
+  , timeouts_{state_->config.timeouts}
+  , readTimeout_{timeouts_.header}
+  , router_{state_->registry}
   , lambda_{*this}
   , dispatcher_{*this}
 {
@@ -71,24 +729,186 @@ Session::Session(boost::asio::ip::tcp::socket&& socket, const Handlers& handlers
 void Session::Run()
 {
   boost::asio::dispatch(stream_.get_executor(),
-      boost::beast::bind_front_handler(&Session::DoRead, shared_from_this()));
+      boost::beast::bind_front_handler(stream_.IsTls() ? &Session::DoHandshake : &Session::DoRead, shared_from_this()));
 }
+
+void Session::DoHandshake()
+{
+  // the handshake is made by the io thread of the session, so the listener accepts the next connection at once
+  reading_ = true;
+  readTimeout_ = timeouts_.header;
+  UpdateTimer();
+
+  stream_.Tls().async_handshake(boost::asio::ssl::stream_base::server,
+      boost::beast::bind_front_handler(&Session::HandleHandshake, shared_from_this()));
+}
+
+void Session::HandleHandshake(boost::beast::error_code ec)
+{
+  reading_ = false;
+
+  if (ec)
+  {
+    COMMON_LOG_DEBUG() << "handshake: " << ec.message();
+    TimerWheel::Disarm(*this);
+    return;
+  }
+
+  DoRead();
+}
+
+bool Session::CanRead() const noexcept
+{
+  return !reading_ && !readClosed_ && queue_.size() < pipelineLimit_;
+}
+
 void Session::DoRead()
 {
-  req_ = {};
-  stream_.expires_after(std::chrono::seconds(30));
+  header_.emplace();
+  // the body limit of the route is applied after the routing
+  header_->body_limit(std::numeric_limits<std::uint64_t>::max());
+  reading_ = true;
 
-  boost::beast::http::async_read(stream_, buffer_, req_,
-      boost::beast::bind_front_handler(&Session::HandleRead, shared_from_this()));
+  if (requests_ && !buffer_.size())
+  {
+    // the keep-alive connection waits for the next request by the idle timeout,
+    // the header is limited by the header timeout from its first byte
+    readTimeout_ = timeouts_.idle;
+    UpdateTimer();
+    stream_.async_read_some(buffer_.prepare(idleReadSize_), Bind(&Session::HandleReadIdle));
+    return;
+  }
+
+  DoReadHeader();
 }
 
-void Session::HandleRead(boost::beast::error_code ec, std::size_t bytesTransferred)
+void Session::DoReadHeader()
+{
+  readTimeout_ = timeouts_.header;
+  UpdateTimer();
+
+  boost::beast::http::async_read_header(stream_, buffer_, *header_,
+      Bind(&Session::HandleReadHeader));
+}
+
+void Session::HandleReadIdle(boost::beast::error_code ec, std::size_t bytesTransferred)
+{
+  if (ec)
+  {
+    // the connection closed by the client between the requests
+    return HandleReadHeader(ec == boost::asio::error::eof ? boost::beast::http::error::end_of_stream : ec, 0);
+  }
+
+  buffer_.commit(bytesTransferred);
+  DoReadHeader();
+}
+
+void Session::HandleReadHeader(boost::beast::error_code ec, std::size_t bytesTransferred)
 {
-  boost::ignore_unused(bytesTransferred);
+  reading_ = false;
+  start_ = std::chrono::steady_clock::now();
+  bytesIn_ = bytesTransferred;
 
   if (ec == boost::beast::http::error::end_of_stream)
   {
-    return DoClose();
+    readClosed_ = true;
+    if (queue_.empty())
+    {
+      DoClose();
+    }
+    return;
+  }
+
+  if (ec)
+  {
+    COMMON_LOG_ERROR() << "read: " << ec.message();
+    return;
+  }
+
+  const auto& header = header_->get();
+  const auto target = header.target();
+  matchRouter_ = router_.Pin();
+  const auto& router = *matchRouter_;
+
+  COMMON_LOG_TRACE() << "Search handlers for uri '" << target << "', method '" << header.method() << "' (total count of handlers: " << router.Size() << ")";
+
+  match_ = router.Find(std::string_view{target.data(), target.size()}, header.method());
+  matchTarget_ = target.data();
+
+  // the rate limited client doesn't take the slot of the requests in flight
+  if (const auto wait = Limit(header); wait.count())
+  {
+    COMMON_LOG_WARNING() << "Rate limit of the client is exceeded for uri '" << target << "'";
+    const auto retryAfter = std::chrono::ceil<std::chrono::seconds>(wait);
+    return Reject(HttpRequest{std::move(header_->release().base())}, boost::beast::http::status::too_many_requests, retryAfter);
+  }
+
+  const auto* context = match_.context;
+
+  // the long-lived stream is counted by its own limit, it doesn't hold the slot of the requests in flight
+  const bool longLived = context && context->longLived;
+  ticket_ = longLived ? state_->admission.AdmitStream() : state_->admission.AdmitRequest();
+  if (!ticket_)
+  {
+    COMMON_LOG_WARNING() << "Limit of the " << (longLived ? "streams" : "requests in flight") << " is reached";
+    return Reject(HttpRequest{std::move(header_->release().base())}, boost::beast::http::status::service_unavailable);
+  }
+
+  if (context && context->webSocket)
+  {
+    if (!boost::beast::websocket::is_upgrade(header))
+    {
+      return Reject(HttpRequest{std::move(header_->release().base())}, boost::beast::http::status::upgrade_required);
+    }
+    return Upgrade(HttpRequest{std::move(header_->release().base())});
+  }
+
+  const auto limit = context && context->options.bodyLimit ? *context->options.bodyLimit : bodyLimit_;
+
+  if (header_->content_length() && *header_->content_length() > limit)
+  {
+    COMMON_LOG_WARNING() << "Request body " << *header_->content_length() << " exceeds the limit " << limit;
+    return Reject(HttpRequest{std::move(header_->release().base())}, boost::beast::http::status::payload_too_large);
+  }
+
+  if (context && context->streamHandler)
+  {
+    consumer_ = context->streamHandler(header);
+    if (!consumer_)
+    {
+      return Reject(HttpRequest{std::move(header_->release().base())}, boost::beast::http::status::bad_request);
+    }
+
+    streamParser_.emplace(std::move(*header_));
+    streamParser_->body_limit(limit);
+    chunk_.resize(chunkSize_);
+    return DoReadChunk();
+  }
+
+  if (header_->is_done())
+  {
+    return Dispatch(HttpRequest{std::move(header_->release().base())});
+  }
+
+  parser_.emplace(std::move(*header_));
+  parser_->body_limit(limit);
+  reading_ = true;
+  readTimeout_ = timeouts_.body;
+  UpdateTimer();
+
+  boost::beast::http::async_read(stream_, buffer_, *parser_,
+      Bind(&Session::HandleRead));
+}
+
+void Session::HandleRead(boost::beast::error_code ec, std::size_t bytesTransferred)
+{
+  reading_ = false;
+  bytesIn_ += bytesTransferred;
+
+  if (ec == boost::beast::http::error::body_limit)
+  {
+    COMMON_LOG_WARNING() << "Request body exceeds the limit";
+    return Reject(HttpRequest{std::move(parser_->release().base())}, boost::beast::http::status::payload_too_large);
   }
 
   if (ec)
@@ -97,13 +917,248 @@ void Session::HandleRead(boost::beast::error_code ec, std::size_t bytesTransferr
     return;
   }
 
-  dispatcher_(req_);
+  Dispatch(parser_->release());
+}
+
+void Session::DoReadChunk()
+{
+  auto& body = streamParser_->get().body();
+  body.data = chunk_.data();
+  body.size = chunk_.size();
+  body.more = true;
+
+  reading_ = true;
+  readTimeout_ = timeouts_.body;
+  UpdateTimer();
 
+  boost::beast::http::async_read_some(stream_, buffer_, *streamParser_,
+      Bind(&Session::HandleReadChunk));
+}
+
+void Session::HandleReadChunk(boost::beast::error_code ec, std::size_t bytesTransferred)
+{
+  reading_ = false;
+  bytesIn_ += bytesTransferred;
+
+  if (ec == boost::beast::http::error::need_buffer)
+  {
+    ec = {};
+  }
+
+  if (ec == boost::beast::http::error::body_limit)
+  {
+    COMMON_LOG_WARNING() << "Streamed request body exceeds the limit";
+    consumer_.reset();
+    return Reject(HttpRequest{std::move(streamParser_->release().base())}, boost::beast::http::status::payload_too_large);
+  }
+
+  if (ec)
+  {
+    COMMON_LOG_ERROR() << "read: " << ec.message();
+    consumer_.reset();
+    return;
+  }
+
+  const auto size = chunk_.size() - streamParser_->get().body().size;
+  if (size)
+  {
+    consumer_->OnChunk(std::string_view{chunk_.data(), size});
+  }
+
+  if (!streamParser_->is_done())
+  {
+    return DoReadChunk();
+  }
+
+  auto& slot = Push(HttpRequest{std::move(streamParser_->release().base())});
+  auto consumer = std::move(consumer_);
+  consumer->OnComplete(slot.request.base(), Responder{MakeShared<Reply>(shared_from_this(), slot)});
+
+  if (CanRead())
+  {
+    DoRead();
+  }
+}
+
+Session::Slot& Session::Push(HttpRequest&& request)
+{
+  // the next request is read only below the pipeline limit, so the slot isn't overwritten
+  BOOST_ASSERT(!queue_.full());
+  queue_.push_back(Slot{std::move(request)});
+
+  auto& slot = queue_.back();
+  slot.ticket = std::move(ticket_);
+  slot.start = start_;
+  slot.bytesIn = bytesIn_;
+  requests_++;
+  readClosed_ = !slot.request.keep_alive();
+
+  // the router is reloaded by the next request, the slot keeps the contexts of its match alive
+  slot.router = std::move(matchRouter_);
+
+  // the parameters refer to the target of the request before the move
+  slot.match = std::move(match_);
+  const auto target = slot.request.target();
+  for (auto& param : slot.match.params)
+  {
+    param.value = std::string_view{target.data() + (param.value.data() - matchTarget_), param.value.size()};
+  }
+
+  return slot;
+}
+
+bool Session::FromCache(Slot& slot)
+{
+  const auto& request = slot.request;
+  if (request.method() != boost::beast::http::verb::get && request.method() != boost::beast::http::verb::head)
+  {
+    return false;
+  }
+
+  auto& cache = *slot.match.context->cache;
+  slot.cacheKey = cache.Key(request);
+
+  const auto cached = cache.Find(slot.cacheKey);
+  if (!cached)
+  {
+    return false;
+  }
+
+  // the cached response isn't stored again
+  slot.cacheKey.clear();
+
+  const auto etag = (*cached)[boost::beast::http::field::etag];
+  if (IsNotModified(request, std::string_view{etag.data(), etag.size()}))
+  {
+    lambda_(slot, MakeResponseForNotModified(request, std::string_view{etag.data(), etag.size()}));
+    return true;
+  }
+
+  // the header is copied, the body is written from the cached response
+  SharedResponse response{cached->base()};
+  response.version(request.version());
+  response.keep_alive(request.keep_alive());
+  if (request.method() != boost::beast::http::verb::head)
+  {
+    response.body() = SharedBody::value_type{cached->body().data(), cached->body().size(), cached};
+  }
+  lambda_(slot, std::move(response));
+  return true;
+}
+
+bool Session::Coalesce(Slot& slot)
+{
+  const auto& request = slot.request;
+  const auto& context = *slot.match.context;
+  if ((request.method() != boost::beast::http::verb::get && request.method() != boost::beast::http::verb::head)
+      || (!context.handler && !context.routeHandler && !context.asyncHandler))
+  {
+    return false;
+  }
+
+  auto& coalescer = *context.coalescer;
+  auto leader = coalescer.Join(coalescer.Key(request), request, Responder{MakeShared<Reply>(shared_from_this(), slot)});
+  if (!leader)
+  {
+    // the response of the flight is posted to the strand of the session
+    return true;
+  }
+
+  if (context.asyncHandler)
+  {
+    context.asyncHandler(request, std::move(*leader));
+    return true;
+  }
+
+  Stopwatch watch;
+  auto response = context.routeHandler ? context.routeHandler(request, slot.match.params) : context.handler(request);
+  COMMON_LOG_TRACE() << "Request processing completed "  << (watch.Get() * 1000.0) << " ms";
+  (*leader)(std::move(response));
+  return true;
+}
+
+void Session::Dispatch(HttpRequest&& request)
+{
+  dispatcher_(Push(std::move(request)));
+
+  // the next pipelined request is read while the responses are produced
+  if (CanRead())
+  {
+    DoRead();
+  }
+
+  UpdateTimer();
+}
+
+RateLimiter::Clock::duration Session::Limit(const HttpRequestHeader& header)
+{
+  if (!match_.context || !match_.context->rateLimiter)
+  {
+    return RateLimiter::Clock::duration::zero();
+  }
+
+  if (!remote_)
+  {
+    boost::beast::error_code ec;
+    const auto endpoint = stream_.Socket().remote_endpoint(ec);
+    if (ec)
+    {
+      // the connection is being closed, the request fails on the write
+      return RateLimiter::Clock::duration::zero();
+    }
+    remote_ = endpoint.address();
+  }
+
+  return match_.context->rateLimiter->Acquire(header, *remote_, start_);
+}
+
+void Session::Reject(HttpRequest&& request, boost::beast::http::status status, std::chrono::seconds retryAfter)
+{
+  // the body isn't read, so the connection is closed after the response
+  auto& slot = Push(std::move(request));
+  readClosed_ = true;
+
+  const auto reason = boost::beast::http::obsolete_reason(status);
+  auto response = MakeResponse(slot.request, status, "application/json", "UTF-8", std::string_view{reason.data(), reason.size()});
+  response.keep_alive(false);
+  if (boost::beast::http::status::service_unavailable == status)
+  {
+    response.set(boost::beast::http::field::retry_after, std::to_string(state_->config.limits.retryAfter.count()));
+  }
+  else if (retryAfter.count())
+  {
+    response.set(boost::beast::http::field::retry_after, std::to_string(retryAfter.count()));
+  }
+  lambda_(slot, std::move(response));
+  UpdateTimer();
+}
+
+void Session::Upgrade(HttpRequest&& request)
+{
+  auto& slot = Push(std::move(request));
+  // the requests after the upgrade aren't http
+  readClosed_ = true;
+  slot.status = static_cast<unsigned>(boost::beast::http::status::switching_protocols);
+  slot.response = std::make_unique<UpgradeWork>(*this, slot);
+
+  DoWrite();
+}
+
+void Session::DoWrite()
+{
+  if (writing_ || queue_.empty() || !queue_.front().response)
+  {
+    return;
+  }
+
+  writing_ = true;
+  UpdateTimer();
+  (*queue_.front().response)();
 }
 
 void Session::HandleWrite(bool close, boost::beast::error_code ec, std::size_t bytesTransferred)
 {
-  boost::ignore_unused(bytesTransferred);
+  writing_ = false;
 
   if (ec)
   {
@@ -111,20 +1166,131 @@ void Session::HandleWrite(bool close, boost::beast::error_code ec, std::size_t b
     return;
   }
 
-  if (close)
+  Record(queue_.front(), bytesTransferred);
+  queue_.pop_front();
+
+  if (close || (readClosed_ && queue_.empty()))
   {
     return DoClose();
   }
 
-  res_ = nullptr;
+  DoWrite();
 
-  DoRead();
+  if (CanRead())
+  {
+    DoRead();
+  }
+
+  UpdateTimer();
+}
+
+bool Session::IsClosing(const Slot& slot) noexcept
+{
+  if (!state_->draining.load(std::memory_order_relaxed))
+  {
+    return false;
+  }
+
+  // the pipelined requests are answered, the requests after them aren't read
+  readClosed_ = true;
+  return &slot == &queue_.back();
+}
+
+void Session::Record(const Slot& slot, std::size_t bytesOut) const noexcept
+{
+  if (!state_->config.metrics.enabled)
+  {
+    return;
+  }
+
+  const auto* context = slot.match.context;
+  auto& metrics = context && context->metrics ? *context->metrics : state_->metrics.Unmatched();
+  metrics.Record(slot.status, std::chrono::steady_clock::now() - slot.start, slot.bytesIn, bytesOut);
 }
 
 void Session::DoClose()
 {
+  TimerWheel::Disarm(*this);
+
+  if (stream_.IsTls() && !reading_)
+  {
+    // close_notify is limited by the write timeout
+    writing_ = true;
+    UpdateTimer();
+    stream_.Tls().async_shutdown([self = shared_from_this()](boost::beast::error_code)
+        {
+          self->writing_ = false;
+          TimerWheel::Disarm(*self);
+          self->stream_.Close();
+        });
+    return;
+  }
+
+  if (stream_.IsTls())
+  {
+    // the shutdown of TLS isn't made during the read
+    return stream_.Close();
+  }
+
   boost::beast::error_code ec;
-  stream_.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ec);
+  stream_.Socket().shutdown(boost::asio::ip::tcp::socket::shutdown_send, ec);
+}
+
+void Session::Abort() noexcept
+{
+  // the io threads are stopped, the completions of the cancelled operations release the session
+  TimerWheel::Disarm(*this);
+  consumer_.reset();
+  if (!upgraded_)
+  {
+    stream_.Close();
+  }
+}
+
+void Session::Shutdown()
+{
+  boost::asio::post(executor_, [self = shared_from_this(), ticket = state_->admission.HoldRequest()]() mutable
+      {
+        const auto events = self->upgraded_ ? nullptr : self->events_.lock();
+        if (events)
+        {
+          // the requests after the stream aren't read, the connection is closed after the end
+          self->readClosed_ = true;
+          events->Shutdown(std::move(ticket));
+        }
+      });
+}
+
+void Session::OnExpire(TimerWheel::Tick deadline)
+{
+  boost::asio::post(stream_.get_executor(), [self = shared_from_this(), deadline]
+      {
+        // the deadline is changed by the progress after the tick
+        if (self->Deadline() != deadline)
+        {
+          return;
+        }
+
+        COMMON_LOG_DEBUG() << "Session timeout (" << (self->writing_ ? "write" : "read") << ")";
+        self->consumer_.reset();
+        self->stream_.Close();
+      });
+}
+
+void Session::UpdateTimer()
+{
+  if (writing_)
+  {
+    wheel_.Arm(shared_from_this(), timeouts_.write);
+  }
+  else if (reading_ && queue_.empty())
+  {
+    wheel_.Arm(shared_from_this(), readTimeout_);
+  }
+  else
+  {
+    TimerWheel::Disarm(*this);
+  }
 }
     
 }
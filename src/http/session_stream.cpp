@@ -0,0 +1,38 @@
+//! @file session_stream.cpp
+//! @brief The implementation stream of the http session (TCP or TLS)
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// this
+#include <cmntype/http/session_stream.h>
+
+namespace common
+{
+namespace http
+{
+
+SessionStream::SessionStream(ConnectionSocket&& socket, boost::asio::ssl::context* context)
+{
+  if (context)
+  {
+    tls_.emplace(std::move(socket), *context);
+  }
+  else
+  {
+    tcp_.emplace(std::move(socket));
+  }
+}
+
+TcpStream& SessionStream::next_layer() noexcept
+{
+  return tls_ ? tls_->next_layer() : *tcp_;
+}
+
+void SessionStream::Close() noexcept
+{
+  next_layer().close();
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,354 @@
+//! @file static_files.cpp
+//! @brief The implementation static files route of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <charconv>
+#include <ctime>
+#include <optional>
+
+// this
+#include <cmntype/http/static_files.h>
+#include <cmntype/http/http_response.h>
+#include <cmntype/logger/logger.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+enum class Range
+{
+  none,
+  satisfiable,
+  unsatisfiable
+};
+
+std::string_view ToStringView(boost::beast::string_view value)
+{
+  return std::string_view{value.data(), value.size()};
+}
+
+int FromHex(char c)
+{
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/// @brief Decode the percent-encoded path, the path must not leave the root
+bool DecodePath(std::string_view path, std::string& result)
+{
+  result.clear();
+  result.reserve(path.size());
+
+  for (std::size_t i = 0; i < path.size(); ++i)
+  {
+    auto c = path[i];
+    if (c == '%')
+    {
+      if (i + 2 >= path.size())
+      {
+        return false;
+      }
+      const auto high = FromHex(path[i + 1]);
+      const auto low = FromHex(path[i + 2]);
+      if (high < 0 || low < 0)
+      {
+        return false;
+      }
+      c = static_cast<char>(high * 16 + low);
+      i += 2;
+    }
+
+    if (c == '\0' || c == '\\')
+    {
+      return false;
+    }
+    result.push_back(c);
+  }
+
+  std::string_view rest{result};
+  while (!rest.empty())
+  {
+    const auto segment = rest.substr(0, rest.find('/'));
+    if (segment == "..")
+    {
+      return false;
+    }
+    rest.remove_prefix(std::min(rest.size(), segment.size() + 1));
+  }
+
+  return true;
+}
+
+bool ParseNumber(std::string_view text, std::uint64_t& value)
+{
+  if (text.empty())
+  {
+    return false;
+  }
+  const auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+  return result.ec == std::errc{} && result.ptr == text.data() + text.size();
+}
+
+/// @brief Parse the single range 'bytes=a-b', 'bytes=a-', 'bytes=-n', the multiple ranges are ignored
+Range ParseRange(std::string_view value, std::uint64_t size, std::uint64_t& offset, std::uint64_t& length)
+{
+  constexpr std::string_view unit{"bytes="};
+  if (value.compare(0, unit.size(), unit) != 0)
+  {
+    return Range::none;
+  }
+
+  value.remove_prefix(unit.size());
+  const auto dash = value.find('-');
+  if (dash == std::string_view::npos || value.find(',') != std::string_view::npos)
+  {
+    return Range::none;
+  }
+
+  const auto first = value.substr(0, dash);
+  const auto last = value.substr(dash + 1);
+  std::uint64_t begin = 0;
+  std::uint64_t end = 0;
+
+  if (first.empty())
+  {
+    if (!ParseNumber(last, end))
+    {
+      return Range::none;
+    }
+    if (end == 0 || size == 0)
+    {
+      return Range::unsatisfiable;
+    }
+    length = std::min(end, size);
+    offset = size - length;
+    return Range::satisfiable;
+  }
+
+  if (!ParseNumber(first, begin))
+  {
+    return Range::none;
+  }
+
+  if (last.empty())
+  {
+    end = size ? size - 1 : 0;
+  }
+  else if (!ParseNumber(last, end) || end < begin)
+  {
+    return Range::none;
+  }
+
+  if (begin >= size)
+  {
+    return Range::unsatisfiable;
+  }
+
+  end = std::min(end, size - 1);
+  offset = begin;
+  length = end - begin + 1;
+  return Range::satisfiable;
+}
+
+/// @brief Parse the date 'Sun, 06 Nov 1994 08:49:37 GMT' (IMF-fixdate, RFC 7231)
+std::optional<std::time_t> ParseHttpDate(std::string_view value)
+{
+  constexpr std::string_view months{"JanFebMarAprMayJunJulAugSepOctNovDec"};
+
+  // the name of the day isn't checked
+  const auto comma = value.find(", ");
+  if (comma == std::string_view::npos)
+  {
+    return {};
+  }
+
+  // '06 Nov 1994 08:49:37 GMT'
+  value.remove_prefix(comma + 2);
+  if (value.size() != 24 || value[2] != ' ' || value[6] != ' ' || value[11] != ' ' || value[14] != ':' ||
+      value[17] != ':' || value.substr(20) != " GMT")
+  {
+    return {};
+  }
+
+  const auto month = months.find(value.substr(3, 3));
+  std::uint64_t day = 0;
+  std::uint64_t year = 0;
+  std::uint64_t hours = 0;
+  std::uint64_t minutes = 0;
+  std::uint64_t seconds = 0;
+
+  if (month == std::string_view::npos || month % 3 != 0 || !ParseNumber(value.substr(0, 2), day) ||
+      !ParseNumber(value.substr(7, 4), year) || !ParseNumber(value.substr(12, 2), hours) ||
+      !ParseNumber(value.substr(15, 2), minutes) || !ParseNumber(value.substr(18, 2), seconds) ||
+      day < 1 || day > 31 || year < 1970 || hours > 23 || minutes > 59 || seconds > 60)
+  {
+    return {};
+  }
+
+  // days since the epoch of the civil date (the year starts in March, so the leap day is the last one)
+  const auto m = static_cast<std::int64_t>(month / 3 + 1);
+  const auto y = static_cast<std::int64_t>(year) - (m <= 2 ? 1 : 0);
+  const auto era = y / 400;
+  const auto yearOfEra = y - era * 400;
+  const auto dayOfYear = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + static_cast<std::int64_t>(day) - 1;
+  const auto dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  const auto days = era * 146097 + dayOfEra - 719468;
+
+  return static_cast<std::time_t>(days * 86400 + static_cast<std::int64_t>(hours * 3600 + minutes * 60 + seconds));
+}
+
+/// @brief The file isn't modified after the date of 'If-Modified-Since'
+bool IsNotModifiedSince(const HttpRequest& request, const File& file)
+{
+  const auto date = ParseHttpDate(ToStringView(request[beast_http::field::if_modified_since]));
+  return date && file.Modified() <= *date;
+}
+
+HttpResponse MakeNotModified(const HttpRequest& request, const File& file)
+{
+  auto response = MakeResponseForNotModified(request, file.ETag());
+  response.set(beast_http::field::last_modified, file.LastModified());
+  return response;
+}
+}  // namespace
+
+StaticFiles::StaticFiles(const filesystem::path& root, const StaticFilesOptions& options)
+: root_{root.string()}
+, options_{options}
+, cache_{options.cacheSize, options.revalidate}
+{
+  while (!root_.empty() && root_.back() == '/')
+  {
+    root_.pop_back();
+  }
+}
+
+StaticFiles::Reply StaticFiles::Serve(const HttpRequest& request, std::string_view path) const
+{
+  std::string relative;
+  if (!DecodePath(path, relative))
+  {
+    COMMON_LOG_WARNING() << "Invalid path of the static file '" << path << "'";
+    return MakeResponseForBadRequest(request, "text/plain", "UTF-8", "invalid path");
+  }
+
+  if (relative.empty() || relative.back() == '/')
+  {
+    relative += options_.index;
+  }
+
+  boost::beast::error_code ec;
+  const auto file = cache_.Open(root_ + '/' + relative, ec);
+  if (ec)
+  {
+    COMMON_LOG_WARNING() << "Static file '" << relative << "' isn't opened: " << ec.message();
+    return MakeResponseForNotFound(request, "text/plain", "UTF-8", "not found");
+  }
+
+  if (request.count(beast_http::field::if_none_match))
+  {
+    if (IsNotModified(request, file->ETag()))
+    {
+      return MakeNotModified(request, *file);
+    }
+  }
+  else if (IsNotModifiedSince(request, *file))
+  {
+    return MakeNotModified(request, *file);
+  }
+
+  FileResponse response;
+  response.file = file;
+  response.size = file->Size();
+
+  auto& header = response.header;
+  header.version(request.version());
+  header.result(beast_http::status::ok);
+
+  const auto range = ToStringView(request[beast_http::field::range]);
+  const auto ifRange = ToStringView(request[beast_http::field::if_range]);
+
+  if (!range.empty() && (ifRange.empty() || ifRange == file->ETag() || ifRange == file->LastModified()))
+  {
+    switch (ParseRange(range, file->Size(), response.offset, response.size))
+    {
+      case Range::satisfiable:
+      {
+        header.result(beast_http::status::partial_content);
+        header.set(beast_http::field::content_range, "bytes " + std::to_string(response.offset) + "-" +
+                                                         std::to_string(response.offset + response.size - 1) + "/" +
+                                                         std::to_string(file->Size()));
+        break;
+      }
+      case Range::unsatisfiable:
+      {
+        auto error = MakeResponse(request, beast_http::status::range_not_satisfiable, "text/plain", "UTF-8", "");
+        error.set(beast_http::field::content_range, "bytes */" + std::to_string(file->Size()));
+        return error;
+      }
+      case Range::none:
+        break;
+    }
+  }
+
+  header.set(beast_http::field::server, BOOST_BEAST_VERSION_STRING);
+  const auto mime = MimeType(relative);
+  header.set(beast_http::field::content_type, boost::beast::string_view{mime.data(), mime.size()});
+  header.set(beast_http::field::etag, file->ETag());
+  header.set(beast_http::field::last_modified, file->LastModified());
+  header.set(beast_http::field::accept_ranges, "bytes");
+  header.content_length(response.size);
+  header.keep_alive(request.keep_alive());
+
+  if (request.method() == beast_http::verb::head)
+  {
+    response.size = 0;
+  }
+
+  return response;
+}
+
+std::string_view MimeType(std::string_view path)
+{
+  using boost::beast::iequals;
+
+  const auto pos = path.rfind('.');
+  const auto ext = pos == std::string_view::npos ? std::string_view{} : path.substr(pos);
+  const boost::beast::string_view e{ext.data(), ext.size()};
+
+  if (iequals(e, ".htm")) return "text/html";
+  if (iequals(e, ".html")) return "text/html";
+  if (iequals(e, ".css")) return "text/css";
+  if (iequals(e, ".txt")) return "text/plain";
+  if (iequals(e, ".js")) return "application/javascript";
+  if (iequals(e, ".json")) return "application/json";
+  if (iequals(e, ".xml")) return "application/xml";
+  if (iequals(e, ".pdf")) return "application/pdf";
+  if (iequals(e, ".zip")) return "application/zip";
+  if (iequals(e, ".gz")) return "application/gzip";
+  if (iequals(e, ".png")) return "image/png";
+  if (iequals(e, ".jpe")) return "image/jpeg";
+  if (iequals(e, ".jpeg")) return "image/jpeg";
+  if (iequals(e, ".jpg")) return "image/jpeg";
+  if (iequals(e, ".gif")) return "image/gif";
+  if (iequals(e, ".bmp")) return "image/bmp";
+  if (iequals(e, ".ico")) return "image/vnd.microsoft.icon";
+  if (iequals(e, ".tiff")) return "image/tiff";
+  if (iequals(e, ".tif")) return "image/tiff";
+  if (iequals(e, ".svg")) return "image/svg+xml";
+  if (iequals(e, ".svgz")) return "image/svg+xml";
+  return "application/octet-stream";
+}
+
+}  // namespace http
+}  // namespace common
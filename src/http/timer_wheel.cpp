@@ -0,0 +1,138 @@
+//! @file timer_wheel.cpp
+//! @brief The implementation timer wheel of the sessions timeouts
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+
+// this
+#include <cmntype/http/timer_wheel.h>
+
+namespace common
+{
+namespace http
+{
+
+TimerWheel::TimerWheel(boost::asio::io_context& io, std::chrono::milliseconds resolution, std::size_t slots)
+: timer_{io}
+, resolution_{std::max(resolution, std::chrono::milliseconds{1})}
+, slots_(std::max<std::size_t>(slots, 2))
+{
+}
+
+void TimerWheel::Start()
+{
+  stop_ = false;
+  Wait();
+}
+
+void TimerWheel::Stop()
+{
+  // the pending wait is cancelled by the next start or by the destruction
+  stop_ = true;
+}
+
+void TimerWheel::Arm(const std::shared_ptr<Client>& client, std::chrono::milliseconds timeout)
+{
+  const auto ticks = static_cast<Tick>((timeout + resolution_ - std::chrono::milliseconds{1}) / resolution_);
+  const auto deadline = now_.load(std::memory_order_acquire) + ticks + 1;
+
+  client->deadline_.store(deadline);
+  Schedule(client, deadline);
+}
+
+void TimerWheel::Disarm(Client& client) noexcept
+{
+  client.deadline_.store(never);
+}
+
+std::size_t TimerWheel::Size() const
+{
+  std::lock_guard<std::mutex> lock{m_};
+
+  std::size_t size = 0;
+  for (const auto& slot : slots_)
+  {
+    size += slot.size();
+  }
+  return size;
+}
+
+void TimerWheel::Schedule(const std::shared_ptr<Client>& client, Tick tick)
+{
+  // the client waits in the earliest slot only, the later deadline is rescheduled by the visit
+  auto scheduled = client->scheduled_.load();
+  while (tick < scheduled)
+  {
+    if (client->scheduled_.compare_exchange_weak(scheduled, tick))
+    {
+      std::lock_guard<std::mutex> lock{m_};
+      slots_[tick % slots_.size()].push_back(client);
+      return;
+    }
+  }
+}
+
+void TimerWheel::Wait()
+{
+  timer_.expires_after(resolution_);
+  timer_.async_wait([this](boost::system::error_code ec) { OnTick(ec); });
+}
+
+void TimerWheel::OnTick(boost::system::error_code ec)
+{
+  if (ec || stop_)
+  {
+    return;
+  }
+
+  const auto now = now_.fetch_add(1, std::memory_order_acq_rel) + 1;
+  const auto index = now % slots_.size();
+
+  {
+    std::lock_guard<std::mutex> lock{m_};
+    visited_.swap(slots_[index]);
+  }
+
+  for (const auto& weak : visited_)
+  {
+    const auto client = weak.lock();
+    if (!client)
+    {
+      continue;
+    }
+
+    const auto scheduled = client->scheduled_.load();
+    if (scheduled != now)
+    {
+      // the entry of the next round is kept, the stale entry is dropped
+      if (scheduled != never && scheduled > now && scheduled % slots_.size() == index)
+      {
+        std::lock_guard<std::mutex> lock{m_};
+        slots_[index].push_back(client);
+      }
+      continue;
+    }
+
+    // the deadline is read after the reset, so the concurrent arming isn't lost
+    client->scheduled_.store(never);
+    const auto deadline = client->deadline_.load();
+
+    if (deadline <= now)
+    {
+      client->OnExpire(deadline);
+    }
+    else if (deadline != never)
+    {
+      Schedule(client, deadline);
+    }
+  }
+
+  visited_.clear();
+  Wait();
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,65 @@
+//! @file tls.cpp
+//! @brief The implementation TLS context of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// this
+#include <cmntype/http/tls.h>
+#include <cmntype/error/error.h>
+
+namespace common
+{
+namespace http
+{
+
+std::unique_ptr<boost::asio::ssl::context> MakeTlsContext(const Configuration::Tls& config)
+{
+  if (!config.enabled)
+  {
+    return nullptr;
+  }
+
+  namespace ssl = boost::asio::ssl;
+
+  auto context = std::make_unique<ssl::context>(ssl::context::tls_server);
+
+  boost::system::error_code ec;
+  context->set_options(ssl::context::default_workarounds | ssl::context::no_sslv2 | ssl::context::no_sslv3 |
+      ssl::context::no_tlsv1 | ssl::context::no_tlsv1_1 | ssl::context::single_dh_use, ec);
+  THROW_IF_ERROR(ec);
+
+  context->use_certificate_chain_file(config.certificate, ec);
+  THROW_IF_ERROR(ec);
+
+  context->use_private_key_file(config.privateKey, ssl::context::pem, ec);
+  THROW_IF_ERROR(ec);
+
+  auto* native = context->native_handle();
+
+  // the cached session is resumed only by the same context
+  static constexpr unsigned char sessionId[] = "cmntype_http";
+  SSL_CTX_set_session_id_context(native, sessionId, sizeof(sessionId) - 1);
+
+  if (config.sessionCacheSize)
+  {
+    SSL_CTX_set_session_cache_mode(native, SSL_SESS_CACHE_SERVER);
+    SSL_CTX_sess_set_cache_size(native, static_cast<long>(config.sessionCacheSize));
+  }
+  else
+  {
+    SSL_CTX_set_session_cache_mode(native, SSL_SESS_CACHE_OFF);
+  }
+
+  SSL_CTX_set_timeout(native, static_cast<long>(config.sessionTimeout.count()));
+
+  if (!config.tickets)
+  {
+    SSL_CTX_set_options(native, SSL_OP_NO_TICKET);
+  }
+
+  return context;
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,82 @@
+//! @file websocket.cpp
+//! @brief The implementation WebSocket connection and broadcast channel
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <algorithm>
+
+// this
+#include <cmntype/http/websocket.h>
+
+namespace common
+{
+namespace http
+{
+
+WebSocket::WebSocket(std::shared_ptr<Sink> sink)
+: sink_{std::move(sink)}
+{
+}
+
+void WebSocket::Send(std::string message, bool text) const
+{
+  sink_->Send(std::make_shared<const std::string>(std::move(message)), text);
+}
+
+void WebSocket::Send(Buffer message, bool text) const
+{
+  sink_->Send(std::move(message), text);
+}
+
+void WebSocket::Close() const
+{
+  sink_->Close();
+}
+
+bool WebSocket::IsOpen() const noexcept
+{
+  return sink_->IsOpen();
+}
+
+void WebSocketChannel::Join(const WebSocket& socket)
+{
+  std::lock_guard<std::mutex> lock{m_};
+  sinks_.push_back(socket.sink_);
+}
+
+std::size_t WebSocketChannel::Publish(std::string message, bool text)
+{
+  return Publish(std::make_shared<const std::string>(std::move(message)), text);
+}
+
+std::size_t WebSocketChannel::Publish(WebSocket::Buffer message, bool text)
+{
+  std::lock_guard<std::mutex> lock{m_};
+
+  const auto end = std::remove_if(sinks_.begin(), sinks_.end(), [&message, text](const auto& weak)
+      {
+        const auto sink = weak.lock();
+        if (!sink || !sink->IsOpen())
+        {
+          return true;
+        }
+
+        // the connections share the buffer of the message
+        sink->Send(WebSocket::Buffer{message}, text);
+        return false;
+      });
+  sinks_.erase(end, sinks_.end());
+
+  return sinks_.size();
+}
+
+std::size_t WebSocketChannel::Size() const
+{
+  std::lock_guard<std::mutex> lock{m_};
+  return sinks_.size();
+}
+
+}  // namespace http
+}  // namespace common
@@ -0,0 +1,234 @@
+//! @file websocket_session.cpp
+//! @brief The implementation WebSocket session
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// this
+#include <cmntype/http/websocket_session.h>
+#include <cmntype/logger/logger.h>
+
+namespace common
+{
+namespace http
+{
+
+namespace websocket = boost::beast::websocket;
+
+WebSocketSession::WebSocketSession(SessionStream&& stream, std::shared_ptr<ServerState> state,
+    Admission::Ticket connection, std::shared_ptr<const WebSocketRoute> route)
+: state_{std::move(state)}
+, connection_{std::move(connection)}
+, route_{std::move(route)}
+, ws_{std::move(stream)}
+{
+}
+
+void WebSocketSession::Run(HttpRequest&& request)
+{
+  request_ = std::move(request);
+
+  // the timeouts of the websocket stream replace the timeouts of the http session
+  boost::beast::get_lowest_layer(ws_).expires_never();
+
+  websocket::stream_base::timeout timeout;
+  timeout.handshake_timeout = state_->config.timeouts.header;
+  timeout.idle_timeout = state_->config.timeouts.idle;
+  timeout.keep_alive_pings = true;
+  ws_.set_option(timeout);
+
+  ws_.set_option(websocket::stream_base::decorator([](websocket::response_type& response)
+      {
+        response.set(boost::beast::http::field::server, BOOST_BEAST_VERSION_STRING);
+      }));
+  ws_.read_message_max(route_->options.messageLimit);
+
+  ws_.async_accept(request_, boost::beast::bind_front_handler(&WebSocketSession::HandleAccept, shared_from_this()));
+}
+
+void WebSocketSession::Send(WebSocket::Buffer&& message, bool text)
+{
+  boost::asio::post(ws_.get_executor(), [self = shared_from_this(), message = std::move(message), text]() mutable
+      {
+        self->Push(Message{std::move(message), text});
+      });
+}
+
+void WebSocketSession::Close()
+{
+  boost::asio::post(ws_.get_executor(), [self = shared_from_this()]
+      {
+        self->DoClose(websocket::close_code::normal);
+      });
+}
+
+void WebSocketSession::Abort() noexcept
+{
+  ws_.next_layer().Close();
+}
+
+void WebSocketSession::Shutdown()
+{
+  boost::asio::post(ws_.get_executor(), [self = shared_from_this(), ticket = state_->admission.HoldRequest()]() mutable
+      {
+        // the connection being accepted is closed after the handshake
+        self->shutdown_ = std::move(ticket);
+        self->DoClose(websocket::close_code::going_away);
+        if (self->finished_)
+        {
+          self->shutdown_.Reset();
+        }
+      });
+}
+
+bool WebSocketSession::IsOpen() const noexcept
+{
+  return open_.load(std::memory_order_relaxed);
+}
+
+void WebSocketSession::HandleAccept(boost::beast::error_code ec)
+{
+  if (ec)
+  {
+    COMMON_LOG_ERROR() << "websocket accept: " << ec.message();
+    shutdown_.Reset();
+    return;
+  }
+
+  open_ = true;
+
+  if (route_->handler.onOpen)
+  {
+    route_->handler.onOpen(request_, WebSocket{shared_from_this()});
+  }
+
+  DoRead();
+
+  if (state_->draining.load(std::memory_order_relaxed))
+  {
+    DoClose(websocket::close_code::going_away);
+  }
+}
+
+void WebSocketSession::DoRead()
+{
+  ws_.async_read(buffer_, boost::beast::bind_front_handler(&WebSocketSession::HandleRead, shared_from_this()));
+}
+
+void WebSocketSession::HandleRead(boost::beast::error_code ec, std::size_t bytesTransferred)
+{
+  if (ec)
+  {
+    if (ec != websocket::error::closed)
+    {
+      COMMON_LOG_DEBUG() << "websocket read: " << ec.message();
+    }
+    return Finish();
+  }
+
+  if (route_->handler.onMessage)
+  {
+    const auto data = buffer_.cdata();
+    route_->handler.onMessage(WebSocket{shared_from_this()},
+        std::string_view{static_cast<const char*>(data.data()), data.size()}, ws_.got_text());
+  }
+
+  buffer_.consume(bytesTransferred);
+  DoRead();
+}
+
+void WebSocketSession::Push(Message&& message)
+{
+  if (!open_)
+  {
+    return;
+  }
+
+  if (queue_.size() >= route_->options.queueLimit)
+  {
+    if (WebSocketOptions::Overflow::drop == route_->options.overflow)
+    {
+      COMMON_LOG_DEBUG() << "Send queue of the websocket is full, the message is dropped";
+      return;
+    }
+
+    COMMON_LOG_WARNING() << "Send queue of the websocket is full, the connection is closed";
+    return DoClose(websocket::close_code::policy_error);
+  }
+
+  queue_.push_back(std::move(message));
+  DoWrite();
+}
+
+void WebSocketSession::DoWrite()
+{
+  if (writing_ || closing_ || queue_.empty())
+  {
+    return;
+  }
+
+  writing_ = true;
+  const auto& message = queue_.front();
+  ws_.text(message.text);
+  ws_.async_write(boost::asio::buffer(*message.data),
+      boost::beast::bind_front_handler(&WebSocketSession::HandleWrite, shared_from_this()));
+}
+
+void WebSocketSession::HandleWrite(boost::beast::error_code ec, std::size_t bytesTransferred)
+{
+  boost::ignore_unused(bytesTransferred);
+
+  writing_ = false;
+  queue_.pop_front();
+
+  if (ec)
+  {
+    COMMON_LOG_DEBUG() << "websocket write: " << ec.message();
+    return Finish();
+  }
+
+  DoWrite();
+}
+
+void WebSocketSession::DoClose(websocket::close_code code)
+{
+  if (closing_ || !open_)
+  {
+    return;
+  }
+
+  closing_ = true;
+  open_ = false;
+
+  // the message being written stays in the queue until its completion
+  queue_.erase(queue_.begin() + (writing_ ? 1 : 0), queue_.end());
+
+  ws_.async_close(code, [self = shared_from_this()](boost::beast::error_code ec)
+      {
+        self->shutdown_.Reset();
+        if (ec)
+        {
+          COMMON_LOG_DEBUG() << "websocket close: " << ec.message();
+        }
+      });
+}
+
+void WebSocketSession::Finish()
+{
+  if (finished_)
+  {
+    return;
+  }
+
+  finished_ = true;
+  open_ = false;
+  shutdown_.Reset();
+
+  if (route_->handler.onClose)
+  {
+    route_->handler.onClose(WebSocket{shared_from_this()});
+  }
+}
+
+}  // namespace http
+}  // namespace common
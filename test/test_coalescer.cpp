@@ -0,0 +1,112 @@
+//! @file test_coalescer.cpp
+//! @brief Define module test for coalescing of the requests
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cmntype/http/coalescer.h>
+#include <cmntype/http/http_response.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+/// @brief Sink storing the response
+class Sink final : public http::Responder::Sink
+{
+public:
+  void Send(http::HttpResponse&& response) override
+  {
+    response_ = std::move(response);
+  }
+
+  void Send(http::SharedResponse&& response) override
+  {
+    body_ = response.body().data();
+    response_ = http::HttpResponse{std::move(response.base())};
+    response_->body().assign(static_cast<const char*>(body_), response.body().size());
+  }
+
+  const std::optional<http::HttpResponse>& Response() const noexcept { return response_; }
+  /// @brief buffer of the shared body, nullptr if the response has own body
+  const void* Body() const noexcept { return body_; }
+
+private:
+  std::optional<http::HttpResponse> response_;
+  const void* body_{nullptr};
+};
+
+http::HttpRequest MakeRequest(std::string_view target, unsigned version = 11)
+{
+  return http::HttpRequest{beast_http::verb::get, boost::beast::string_view{target.data(), target.size()}, version};
+}
+}  // namespace
+
+TEST(Coalescer, Flight)
+{
+  auto coalescer = std::make_shared<http::Coalescer>(http::CoalesceOptions{});
+
+  std::vector<std::shared_ptr<Sink>> sinks;
+  const auto join = [&coalescer, &sinks](const http::HttpRequest& request)
+  {
+    sinks.push_back(std::make_shared<Sink>());
+    return coalescer->Join(coalescer->Key(request), request, http::Responder{sinks.back()});
+  };
+
+  auto leader = join(MakeRequest("/geo?q=1"));
+  ASSERT_TRUE(leader);
+  ASSERT_FALSE(join(MakeRequest("/geo?q=1", 10)));
+  ASSERT_FALSE(join(MakeRequest("/geo?q=1")));
+  auto other = join(MakeRequest("/geo?q=2"));
+  ASSERT_TRUE(other);
+  ASSERT_EQ(coalescer->Size(), 2u);
+  ASSERT_EQ(coalescer->Coalesced(), 2u);
+
+  (*leader)(http::MakeResponse(MakeRequest("/geo?q=1"), beast_http::status::ok, "text/plain", "UTF-8", "first"));
+  ASSERT_EQ(coalescer->Size(), 1u);
+
+  for (std::size_t i = 0; i < 3; i++)
+  {
+    ASSERT_TRUE(sinks[i]->Response());
+    ASSERT_EQ(sinks[i]->Response()->body(), "first");
+  }
+  // the response has the version of its request
+  ASSERT_EQ(sinks[1]->Response()->version(), 10u);
+  // the body is shared by the waiters, it isn't copied
+  ASSERT_NE(sinks[0]->Body(), nullptr);
+  ASSERT_EQ(sinks[0]->Body(), sinks[1]->Body());
+  ASSERT_EQ(sinks[0]->Body(), sinks[2]->Body());
+  ASSERT_FALSE(sinks[3]->Response());
+
+  // the finished flight isn't joined
+  ASSERT_TRUE(join(MakeRequest("/geo?q=1")));
+}
+
+TEST(Coalescer, Dropped)
+{
+  auto coalescer = std::make_shared<http::Coalescer>(http::CoalesceOptions{});
+  const auto request = MakeRequest("/geo");
+  const auto key = coalescer->Key(request);
+
+  auto first = std::make_shared<Sink>();
+  auto second = std::make_shared<Sink>();
+  std::weak_ptr<Sink> released = second;
+
+  auto leader = coalescer->Join(key, request, http::Responder{first});
+  ASSERT_TRUE(leader);
+  ASSERT_FALSE(coalescer->Join(key, request, http::Responder{std::move(second)}));
+
+  // the handler drops the responder, the waiting requests are released without the response
+  leader.reset();
+  ASSERT_EQ(coalescer->Size(), 0u);
+  ASSERT_TRUE(released.expired());
+  ASSERT_FALSE(first->Response());
+}
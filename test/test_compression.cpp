@@ -0,0 +1,173 @@
+//! @file test_compression.cpp
+//! @brief Define module test for compression of the response body
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+#include <gtest/gtest.h>
+
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <boost/crc.hpp>
+
+#include <cmntype/http/compression.h>
+#include <cmntype/http/http_response.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+std::string Inflate(std::string_view data)
+{
+  boost::beast::zlib::inflate_stream stream;
+  std::string result(1024 * 1024, '\0');
+
+  boost::beast::zlib::z_params params;
+  params.next_in = data.data();
+  params.avail_in = data.size();
+  params.next_out = &result[0];
+  params.avail_out = result.size();
+
+  boost::beast::error_code ec;
+  stream.write(params, boost::beast::zlib::Flush::finish, ec);
+  EXPECT_EQ(ec, boost::beast::zlib::error::end_of_stream);
+  result.resize(params.total_out);
+  return result;
+}
+
+std::string MakeBody()
+{
+  std::string body{"["};
+  for (int i = 0; i < 200; i++)
+  {
+    body += R"({"id":)" + std::to_string(i) + R"(,"name":"name of the object"},)";
+  }
+  body.back() = ']';
+  return body;
+}
+
+http::HttpRequest MakeRequest(std::string_view acceptEncoding)
+{
+  http::HttpRequest request{beast_http::verb::get, "/", 11};
+  if (!acceptEncoding.empty())
+  {
+    request.set(beast_http::field::accept_encoding, boost::beast::string_view{acceptEncoding.data(), acceptEncoding.size()});
+  }
+  return request;
+}
+}  // namespace
+
+TEST(Compression, Negotiate)
+{
+  ASSERT_EQ(http::NegotiateCoding(""), http::ContentCoding::identity);
+  ASSERT_EQ(http::NegotiateCoding("identity"), http::ContentCoding::identity);
+  ASSERT_EQ(http::NegotiateCoding("gzip, deflate, br"), http::ContentCoding::gzip);
+  ASSERT_EQ(http::NegotiateCoding("deflate"), http::ContentCoding::deflate);
+  ASSERT_EQ(http::NegotiateCoding("gzip;q=0.5, deflate"), http::ContentCoding::deflate);
+  ASSERT_EQ(http::NegotiateCoding("GZIP ; q=1.0, deflate;q=0.9"), http::ContentCoding::gzip);
+  ASSERT_EQ(http::NegotiateCoding("gzip;q=0, deflate;q=0"), http::ContentCoding::identity);
+  ASSERT_EQ(http::NegotiateCoding("*"), http::ContentCoding::gzip);
+  ASSERT_EQ(http::NegotiateCoding("*, gzip;q=0"), http::ContentCoding::deflate);
+}
+
+TEST(Compression, Compress)
+{
+  const auto body = MakeBody();
+
+  const auto gzip = http::Compress(body, http::ContentCoding::gzip, 6);
+  ASSERT_LT(gzip.size(), body.size() / 4);
+  ASSERT_EQ(gzip.substr(0, 3), std::string("\x1f\x8b\x08"));
+  ASSERT_EQ(Inflate(std::string_view{gzip}.substr(10, gzip.size() - 18)), body);
+
+  boost::crc_32_type crc;
+  crc.process_bytes(body.data(), body.size());
+  const auto* trailer = reinterpret_cast<const unsigned char*>(gzip.data() + gzip.size() - 8);
+  ASSERT_EQ(static_cast<std::uint32_t>(trailer[0] | trailer[1] << 8 | trailer[2] << 16 | trailer[3] << 24), crc.checksum());
+
+  const auto deflate = http::Compress(body, http::ContentCoding::deflate, 1);
+  ASSERT_EQ((static_cast<unsigned char>(deflate[0]) << 8 | static_cast<unsigned char>(deflate[1])) % 31, 0);
+  ASSERT_EQ(Inflate(std::string_view{deflate}.substr(2, deflate.size() - 6)), body);
+}
+
+TEST(Compression, Compressor)
+{
+  const auto body = MakeBody();
+  auto request = MakeRequest("gzip");
+
+  // the compression is off by default
+  http::Configuration::Compression options;
+  auto response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", body);
+  http::Compressor{options}.Apply(request, response, false);
+  ASSERT_EQ(response.body(), body);
+  ASSERT_EQ(response[beast_http::field::vary], "");
+
+  options.enabled = true;
+  options.minSize = 128;
+  options.cacheSize = 1;
+  http::Compressor compressor{options};
+
+  // the small body isn't compressed
+  response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", "[]");
+  compressor.Apply(request, response, false);
+  ASSERT_EQ(response.body(), "[]");
+
+  response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", body);
+  compressor.Apply(request, response, false);
+  ASSERT_EQ(response[beast_http::field::content_encoding], "gzip");
+  ASSERT_EQ(response[beast_http::field::vary], "Accept-Encoding");
+  ASSERT_EQ(response[beast_http::field::content_length], std::to_string(response.body().size()));
+  ASSERT_EQ(compressor.CacheSize(), 0u);
+
+  const auto compressed = response.body();
+
+  // the cacheable body is compressed once
+  for (int i = 0; i < 2; i++)
+  {
+    response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", body);
+    compressor.Apply(request, response, true);
+    ASSERT_EQ(response.body(), compressed);
+    ASSERT_EQ(compressor.CacheSize(), 1u);
+  }
+
+  // the entry is found by the body, the other body of the same size isn't served from it
+  auto other = body;
+  other[7] = '9';
+  response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", other);
+  compressor.Apply(request, response, true);
+  ASSERT_EQ(Inflate(std::string_view{response.body()}.substr(10, response.body().size() - 18)), other);
+
+  // the validator of the compressed body is weak
+  response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", body);
+  response.set(beast_http::field::etag, "\"1f\"");
+  compressor.Apply(request, response, true);
+  ASSERT_EQ(response[beast_http::field::etag], "W/\"1f\"");
+
+  // the client doesn't accept the compression
+  auto identity = MakeRequest("");
+  response = http::MakeResponse(identity, beast_http::status::ok, "application/json", "UTF-8", body);
+  response.set(beast_http::field::etag, "\"1f\"");
+  compressor.Apply(identity, response, true);
+  ASSERT_EQ(response.body(), body);
+  ASSERT_EQ(response[beast_http::field::etag], "\"1f\"");
+  ASSERT_EQ(response[beast_http::field::vary], "Accept-Encoding");
+
+  // 'Vary' of the handler is kept
+  response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", body);
+  response.set(beast_http::field::vary, "Cookie");
+  compressor.Apply(request, response, false);
+  ASSERT_EQ(response[beast_http::field::vary], "Cookie, Accept-Encoding");
+
+  response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", body);
+  response.set(beast_http::field::vary, "Authorization, accept-encoding");
+  compressor.Apply(request, response, false);
+  ASSERT_EQ(response[beast_http::field::vary], "Authorization, accept-encoding");
+
+  // the encoded and not compressible bodies are sent as is
+  response = http::MakeResponse(request, beast_http::status::ok, "application/json", "br", body);
+  compressor.Apply(request, response, false);
+  ASSERT_EQ(response.body(), body);
+
+  response = http::MakeResponse(request, beast_http::status::ok, "image/png", "UTF-8", body);
+  compressor.Apply(request, response, false);
+  ASSERT_EQ(response.body(), body);
+}
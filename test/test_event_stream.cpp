@@ -0,0 +1,18 @@
+//! @file test_event_stream.cpp
+//! @brief Define module test for format of the server-sent events
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+#include <gtest/gtest.h>
+
+#include <cmntype/http/event_stream.h>
+
+namespace http = common::http;
+
+TEST(EventStream, Format)
+{
+  ASSERT_EQ(http::EventStream::Format("text"), "data: text\n\n");
+  ASSERT_EQ(http::EventStream::Format(""), "data: \n\n");
+  ASSERT_EQ(http::EventStream::Format("a\nb\r\nc", "update", "7"), "id: 7\nevent: update\ndata: a\ndata: b\ndata: c\n\n");
+}
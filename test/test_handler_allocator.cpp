@@ -0,0 +1,161 @@
+//! @file test_handler_allocator.cpp
+//! @brief Define module test for recycling allocator of the handlers
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <string_view>
+
+// boost
+#include <boost/asio.hpp>
+#include <boost/log/core.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmntype/http/handler_allocator.h>
+#include <cmntype/http/http_server.h>
+#include <cmntype/http/response_template.h>
+
+// test
+#include <test_env.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+/// @brief the allocations of the whole process are counted while the flag is set
+std::atomic<bool> counting{false};
+std::atomic<std::size_t> allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size)
+{
+  if (counting.load(std::memory_order_relaxed))
+  {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (auto* pointer = std::malloc(size ? size : 1))
+  {
+    return pointer;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+TEST(HandlerAllocator, Recycle)
+{
+  http::HandlerAllocator<char> allocator;
+
+  auto* first = allocator.allocate(100);
+  allocator.deallocate(first, 100);
+
+  // the block of the same size class is reused
+  auto* second = allocator.allocate(120);
+  ASSERT_EQ(first, second);
+  allocator.deallocate(second, 120);
+
+  // the large blocks aren't cached
+  allocations = 0;
+  counting = true;
+  for (int i = 0; i < 10; i++)
+  {
+    allocator.deallocate(allocator.allocate(100), 100);
+  }
+  auto* large = allocator.allocate(1024 * 1024);
+  allocator.deallocate(large, 1024 * 1024);
+  counting = false;
+  ASSERT_EQ(allocations, 1u);
+}
+
+TEST(HandlerAllocator, Handler)
+{
+  boost::asio::io_context io;
+
+  int calls = 0;
+  for (int i = 0; i < 2; i++)
+  {
+    boost::asio::post(io, http::MakeRecyclingHandler([&calls] { calls++; }));
+    io.run();
+    io.restart();
+  }
+  ASSERT_EQ(calls, 2);
+
+  using Handler = http::RecyclingHandler<std::function<void()>>;
+  static_assert(std::is_same_v<boost::asio::associated_allocator_t<Handler>, http::HandlerAllocator<void>>);
+}
+
+TEST(HandlerAllocator, KeepAliveRequests)
+{
+  constexpr std::uint16_t port = common::test::TestEnvironment::GetPort() + 11;
+
+  http::Configuration config;
+  config.metrics.enabled = false;
+
+  http::HttpServer server{common::test::TestEnvironment::GetIp(), port, 1, config};
+  server.AddResponse("/health", beast_http::verb::get,
+      http::MakeResponseTemplate(beast_http::status::ok, "text/plain", "UTF-8", "healthy"));
+  server.Start();
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(common::test::TestEnvironment::GetIp().data()), port});
+
+  // the client doesn't allocate: the request and the response are in the fixed buffers
+  static constexpr std::string_view request{"GET /health HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+  std::array<char, 1024> response;
+  std::size_t size = 0;
+
+  const auto get = [&]
+      {
+        boost::asio::write(socket, boost::asio::buffer(request));
+        std::size_t read = 0;
+        // the body is the end of the response
+        do
+        {
+          read += socket.read_some(boost::asio::buffer(response.data() + read, response.size() - read));
+        }
+        while (std::string_view{response.data(), read}.find("healthy") == std::string_view::npos);
+        size = read;
+      };
+
+  // the logging allocates the records
+  boost::log::core::get()->set_logging_enabled(false);
+
+  // the warm up fills the caches
+  for (int i = 0; i < 100; i++)
+  {
+    get();
+  }
+
+  constexpr std::size_t count = 1000;
+  allocations = 0;
+  counting = true;
+  for (std::size_t i = 0; i < count; i++)
+  {
+    get();
+  }
+  counting = false;
+
+  boost::log::core::get()->set_logging_enabled(true);
+
+  ASSERT_EQ(std::string_view(response.data(), size).substr(0, 15), "HTTP/1.1 200 OK");
+  // only the fields of the request (the target and 'Host') are allocated by the parser
+  ASSERT_LE(allocations, 2 * count + 16);
+
+  server.Stop();
+}
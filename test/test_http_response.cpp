@@ -6,6 +6,8 @@
 
 #include <gtest/gtest.h> 
 
+#include <sstream>
+
 #include <cmntype/http/http_response.h>
 
 #include <cmntype/http/types.h>
@@ -60,3 +62,57 @@ TEST(HttpResponse, ServerError)
 
   ASSERT_EQ(response.result(), boost::beast::http::status::internal_server_error);
 }
+
+TEST(HttpResponse, PayloadTooLarge)
+{
+  auto response = http::MakeResponseForPayloadTooLarge(http::HttpRequest(),
+      "text/plain", "UTF-8", std::string_view{});
+
+  Check(response);
+
+  ASSERT_EQ(response.result(), boost::beast::http::status::payload_too_large);
+  ASSERT_FALSE(response.keep_alive());
+}
+
+TEST(HttpResponse, MovedBody)
+{
+  std::string body(64 * 1024, 'x');
+  const auto* data = body.data();
+
+  auto response = http::MakeResponse(http::HttpRequest(), beast_http::status::ok,
+      content_type, content_encoding, std::move(body));
+
+  Check(response);
+
+  // the buffer of the string is moved into the response
+  ASSERT_EQ(response.body().data(), data);
+  ASSERT_EQ(response[beast_http::field::content_length], std::to_string(64 * 1024));
+
+  // the lvalue is copied
+  const std::string text{"text"};
+  response = http::MakeResponseForNotFound(http::HttpRequest(), content_type, content_encoding, text);
+  ASSERT_EQ(response.body(), text);
+}
+
+TEST(HttpResponse, SharedBody)
+{
+  const auto buffer = std::make_shared<const std::string>("shared body");
+
+  auto response = http::MakeSharedResponse(http::HttpRequest(), beast_http::status::ok,
+      content_type, content_encoding, http::SharedBody::value_type{buffer});
+
+  ASSERT_EQ(response.body().data(), buffer->data());
+  ASSERT_EQ(response[beast_http::field::content_length], std::to_string(buffer->size()));
+  ASSERT_EQ(buffer.use_count(), 2);
+
+  std::ostringstream os;
+  os << response;
+  const auto text = os.str();
+  ASSERT_EQ(text.substr(text.size() - buffer->size()), *buffer);
+
+  // the static data without the owner
+  static constexpr std::string_view data{"static"};
+  const auto other = http::MakeSharedResponse(http::HttpRequest(), beast_http::status::ok,
+      content_type, content_encoding, http::SharedBody::value_type{data.data(), data.size()});
+  ASSERT_EQ(other[beast_http::field::content_length], "6");
+}
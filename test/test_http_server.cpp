@@ -4,18 +4,37 @@
  *  @date 18.12.2019
  */
 // std 
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <thread>
 #include <chrono>
 
 // boost
 #include <boost/format.hpp>
+#include <boost/beast/ssl.hpp>
+#include <boost/beast/websocket.hpp>
+
+// openssl
+#include <openssl/pem.h>
+#include <openssl/x509.h>
+
+// posix
+#include <unistd.h>
 
 // gtest
 #include <gtest/gtest.h>
 
 // common
 #include <cmntype/config.h>
+#include <cmntype/error/error.h>
 #include <cmntype/http/http_server.h>
+#include <cmntype/http/http_response.h>
+#include <cmntype/http/responder.h>
+#include <cmntype/http/response_writer.h>
+#include <cmntype/thread/pool_thread.h>
 #include <cmntype/logger/logger.h>
 
 // test
@@ -236,5 +255,1703 @@ TEST_F(HttpServerTest, NotFoundRequest)
   ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::not_found));
 }
 
+TEST_F(HttpServerTest, NotAllowedRequest)
+{
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  const auto& test = GetTests().at(boost::beast::http::verb::get);
+  GetServer()->AddRequestHandler("/test_get_only", boost::beast::http::verb::get, test.handler);
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_get_only").str();
+  auto response = curl.Post(url, "");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::method_not_allowed));
+}
+
+TEST_F(HttpServerTest, RouteParamsRequest)
+{
+  GetServer()->AddRequestHandler("/test/{id}/name/{name}", boost::beast::http::verb::get,
+      [](const http::HttpRequest& request, const http::RouteParams& params)
+      {
+        http::HttpResponse response{boost::beast::http::status::ok, request.version()};
+        for (const auto& param : params)
+        {
+          response.body() += std::string(param.name) + "=" + std::string(param.value) + ";";
+        }
+        response.prepare_payload();
+        return response;
+      });
+
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test/42/name/moscow?lang=ru").str();
+  auto response = curl.Get(url, "");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::ok));
+  ASSERT_EQ(std::get<0>(response), "id=42;name=moscow;");
+}
+
+TEST_F(HttpServerTest, AsyncRequest)
+{
+  GetServer()->AddRequestHandler("/test_async", boost::beast::http::verb::get,
+      [](const http::HttpRequest& request, http::Responder responder)
+      {
+        std::thread([&request, responder]
+            {
+              std::this_thread::sleep_for(std::chrono::milliseconds(10));
+              responder(http::MakeResponse(request, boost::beast::http::status::ok, "text/plain", "UTF-8", "async"));
+            }).detach();
+      });
+
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_async").str();
+  auto response = curl.Get(url, "");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::ok));
+  ASSERT_EQ(std::get<0>(response), "async");
+}
+
+TEST_F(HttpServerTest, SharedResponse)
+{
+  // the buffer is shared by the responses and isn't copied
+  const auto buffer = std::make_shared<const std::string>(256 * 1024, 's');
+
+  GetServer()->AddRequestHandler("/test_shared", boost::beast::http::verb::get,
+      [buffer](const http::HttpRequest& request, http::Responder responder)
+      {
+        responder(http::MakeSharedResponse(request, boost::beast::http::status::ok, "text/plain", "UTF-8",
+            http::SharedBody::value_type{buffer}));
+      });
+
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_shared").str();
+  for (int i = 0; i < 2; i++)
+  {
+    auto response = curl.Get(url, "");
+    ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::ok));
+    ASSERT_EQ(std::get<0>(response), *buffer);
+  }
+}
+
+TEST_F(HttpServerTest, AsyncRequestWithoutResponse)
+{
+  GetServer()->AddRequestHandler("/test_async_lost", boost::beast::http::verb::get,
+      [](const http::HttpRequest&, http::Responder)
+      {
+      });
+
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_async_lost").str();
+  auto response = curl.Get(url, "");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::internal_server_error));
+}
+
+TEST_F(HttpServerTest, PoolRequest)
+{
+  auto pool = std::make_shared<thread::PoolThread>(2);
+  const auto& test = GetTests().at(boost::beast::http::verb::post);
+  GetServer()->AddRequestHandler("/test_pool", boost::beast::http::verb::post, test.handler, pool);
+  GetServer()->AddRequestHandler("/test_pool_error", boost::beast::http::verb::get,
+      [](const http::HttpRequest&) -> http::HttpResponse
+      {
+        throw std::runtime_error("handler error");
+      }, pool);
+
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_pool").str();
+  auto response = curl.Post(url, test.content);
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(test.code));
+  ASSERT_EQ(std::get<0>(response), test.message);
+
+  url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_pool_error").str();
+  response = curl.Get(url, "");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::internal_server_error));
+}
+
+TEST_F(HttpServerTest, PipelinedRequests)
+{
+  namespace beast_http = boost::beast::http;
+
+  // the following requests are dispatched while the slow response is produced
+  auto dispatched = std::make_shared<std::atomic<int>>(0);
+
+  GetServer()->AddRequestHandler("/test_pipeline/slow", beast_http::verb::get,
+      [dispatched](const http::HttpRequest& request, http::Responder responder)
+      {
+        std::thread([&request, responder, dispatched]
+            {
+              for (int i = 0; i < 100 && *dispatched < 3; i++)
+              {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+              }
+              responder(http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8",
+                    *dispatched == 3 ? "slow" : "not pipelined"));
+            }).detach();
+      });
+  GetServer()->AddRequestHandler("/test_pipeline/{name}", beast_http::verb::get,
+      [dispatched](const http::HttpRequest& request, const http::RouteParams& params)
+      {
+        ++*dispatched;
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", params[0].value);
+      });
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), TestEnvironment::GetPort()});
+
+  const std::vector<std::string> names{"slow", "first", "second", "third"};
+
+  std::string requests;
+  for (const auto& name : names)
+  {
+    requests += "GET /test_pipeline/" + name + " HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  }
+  boost::asio::write(socket, boost::asio::buffer(requests));
+
+  boost::beast::flat_buffer buffer;
+  for (const auto& name : names)
+  {
+    http::HttpResponse response;
+    beast_http::read(socket, buffer, response);
+    ASSERT_EQ(response.result(), beast_http::status::ok);
+    ASSERT_EQ(response.body(), name);
+  }
+}
+
+TEST_F(HttpServerTest, RouteAddedWhilePipelined)
+{
+  namespace beast_http = boost::beast::http;
+
+  auto called = std::make_shared<std::atomic<bool>>(false);
+  auto release = std::make_shared<std::atomic<bool>>(false);
+
+  GetServer()->AddRequestHandler("/test_reload/slow", beast_http::verb::get,
+      [called, release](const http::HttpRequest& request, http::Responder responder)
+      {
+        *called = true;
+        std::thread([&request, responder, release]
+            {
+              for (int i = 0; i < 100 && !*release; i++)
+              {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+              }
+              responder(http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "slow"));
+            }).detach();
+      });
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), TestEnvironment::GetPort()});
+
+  boost::asio::write(socket, boost::asio::buffer(std::string{"GET /test_reload/slow HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+  for (int i = 0; i < 100 && !*called; i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(*called);
+
+  // the new router is published while the slow response is in flight, the next request of the session reloads it
+  GetServer()->AddRequestHandler("/test_reload/added", beast_http::verb::get,
+      [](const http::HttpRequest& request)
+      {
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "added");
+      });
+  boost::asio::write(socket, boost::asio::buffer(std::string{"GET /test_reload/added HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  *release = true;
+
+  boost::beast::flat_buffer buffer;
+  for (const auto* body : {"slow", "added"})
+  {
+    http::HttpResponse response;
+    beast_http::read(socket, buffer, response);
+    ASSERT_EQ(response.result(), beast_http::status::ok);
+    ASSERT_EQ(response.body(), body);
+  }
+}
+
+TEST_F(HttpServerTest, StreamRequest)
+{
+  class Consumer final : public http::BodyConsumer
+  {
+  public:
+    void OnChunk(std::string_view chunk) override
+    {
+      size_ += chunk.size();
+      chunks_++;
+      valid_ = valid_ && chunk.find_first_not_of('x') == std::string_view::npos;
+    }
+
+    void OnComplete(const http::HttpRequestHeader& header, http::Responder responder) override
+    {
+      http::HttpResponse response{boost::beast::http::status::ok, header.version()};
+      response.body() = std::to_string(size_) + (valid_ && chunks_ > 1 ? "" : " invalid");
+      response.prepare_payload();
+      responder(std::move(response));
+    }
+
+  private:
+    std::size_t size_{0};
+    std::size_t chunks_{0};
+    bool valid_{true};
+  };
+
+  constexpr std::size_t size = 4 * 1024 * 1024;
+
+  http::RouteOptions options;
+  options.bodyLimit = size;
+  GetServer()->AddStreamRequestHandler("/test_stream", boost::beast::http::verb::post,
+      [](const http::HttpRequestHeader&) { return std::make_unique<Consumer>(); }, options);
+
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_stream").str();
+  auto response = curl.Post(url, std::string(size, 'x'));
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::ok));
+  ASSERT_EQ(std::get<0>(response), std::to_string(size));
+
+  response = curl.Post(url, std::string(size + 1, 'x'));
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::payload_too_large));
+}
+
+TEST_F(HttpServerTest, BodyLimit)
+{
+  const auto& test = GetTests().at(boost::beast::http::verb::post);
+
+  http::RouteOptions options;
+  options.bodyLimit = test.content.size();
+  GetServer()->AddRequestHandler("/test_limit", boost::beast::http::verb::post, test.handler, options);
+
+  auto& curl = GetCurl();
+  curl.SetHeaders(GetHeaders());
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_limit").str();
+  auto response = curl.Post(url, test.content);
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(test.code));
+  ASSERT_EQ(std::get<0>(response), test.message);
+
+  response = curl.Post(url, test.content + "!");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::payload_too_large));
+}
+
+TEST_F(HttpServerTest, StreamResponse)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::size_t chunks = 64;
+  constexpr std::size_t chunkSize = 64 * 1024;
+
+  // the next chunk is produced after the previous one is written to the socket
+  struct Producer : std::enable_shared_from_this<Producer>
+  {
+    explicit Producer(http::ResponseWriter w)
+      : writer{std::move(w)}
+    {
+    }
+
+    void Next()
+    {
+      if (count == chunks)
+      {
+        return writer.End();
+      }
+
+      writer.Write(std::string(chunkSize, static_cast<char>('a' + count++ % 26)),
+          [self = shared_from_this()](boost::beast::error_code ec)
+          {
+            if (!ec)
+            {
+              self->Next();
+            }
+          });
+    }
+
+    http::ResponseWriter writer;
+    std::size_t count{0};
+  };
+
+  const auto handler = [](const http::HttpRequest&, http::ResponseWriter writer)
+      {
+        http::HttpResponseHeader header;
+        header.result(beast_http::status::ok);
+        header.set(beast_http::field::content_type, "text/plain");
+        writer.Begin(std::move(header));
+
+        std::thread([producer = std::make_shared<Producer>(std::move(writer))] { producer->Next(); }).detach();
+      };
+  GetServer()->AddStreamResponseHandler("/test_stream_response", beast_http::verb::get, handler);
+  GetServer()->AddStreamResponseHandler("/test_stream_response", beast_http::verb::head, handler);
+  GetServer()->AddStreamResponseHandler("/test_stream_response_lost", beast_http::verb::get,
+      [](const http::HttpRequest&, http::ResponseWriter) {});
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), TestEnvironment::GetPort()});
+
+  const std::string request{"GET /test_stream_response HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+  boost::asio::write(socket, boost::asio::buffer(request + request));
+
+  boost::beast::flat_buffer buffer;
+  for (int i = 0; i < 2; i++)
+  {
+    beast_http::response_parser<beast_http::string_body> parser;
+    parser.body_limit(chunks * chunkSize);
+    beast_http::read(socket, buffer, parser);
+
+    const auto& response = parser.get();
+    ASSERT_EQ(response.result(), beast_http::status::ok);
+    ASSERT_TRUE(response.chunked());
+    ASSERT_TRUE(response.keep_alive());
+    ASSERT_EQ(response.body().size(), chunks * chunkSize);
+    ASSERT_EQ(response.body()[chunkSize * 3], 'd');
+  }
+
+  // the response to HEAD is the header only, the next response follows it
+  const std::string head{"HEAD /test_stream_response HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+  boost::asio::write(socket, boost::asio::buffer(head + request));
+  {
+    beast_http::response_parser<beast_http::string_body> parser;
+    parser.skip(true);
+    beast_http::read(socket, buffer, parser);
+    ASSERT_EQ(parser.get().result(), beast_http::status::ok);
+    ASSERT_TRUE(parser.get().chunked());
+    ASSERT_TRUE(parser.get().body().empty());
+
+    beast_http::response_parser<beast_http::string_body> next;
+    next.body_limit(chunks * chunkSize);
+    beast_http::read(socket, buffer, next);
+    ASSERT_EQ(next.get().result(), beast_http::status::ok);
+    ASSERT_EQ(next.get().body().size(), chunks * chunkSize);
+  }
+
+  auto& curl = GetCurl();
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_stream_response").str();
+  auto response = curl.Get(url, "");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(beast_http::status::ok));
+  ASSERT_EQ(std::get<0>(response).size(), chunks * chunkSize);
+
+  url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_stream_response_lost").str();
+  response = curl.Get(url, "");
+  ASSERT_EQ(std::get<1>(response), static_cast<long>(beast_http::status::internal_server_error));
+}
+
+TEST_F(HttpServerTest, CachedResponse)
+{
+  namespace beast_http = boost::beast::http;
+
+  auto calls = std::make_shared<std::atomic<int>>(0);
+
+  http::RouteOptions options;
+  options.cache = http::CacheOptions{};
+  options.cache->ttl = std::chrono::minutes{1};
+  GetServer()->AddRequestHandler("/test_cached/{id}", beast_http::verb::get,
+      [calls](const http::HttpRequest& request, const http::RouteParams& params)
+      {
+        ++*calls;
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", params[0].value);
+      }, options);
+
+  auto& curl = GetCurl();
+  const auto url = [](std::string_view id)
+  {
+    return (boost::format("http://%1%:%2%/test_cached/%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % id).str();
+  };
+
+  for (int i = 0; i < 3; i++)
+  {
+    auto response = curl.Get(url("first"), "");
+    ASSERT_EQ(std::get<1>(response), static_cast<long>(beast_http::status::ok));
+    ASSERT_EQ(std::get<0>(response), "first");
+  }
+  ASSERT_EQ(*calls, 1);
+
+  ASSERT_EQ(std::get<0>(curl.Get(url("second"), "")), "second");
+  ASSERT_EQ(*calls, 2);
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), TestEnvironment::GetPort()});
+
+  boost::asio::write(socket, boost::asio::buffer(std::string{"GET /test_cached/first HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+  boost::beast::flat_buffer buffer;
+  http::HttpResponse response;
+  beast_http::read(socket, buffer, response);
+  const auto etag = std::string(response[beast_http::field::etag]);
+  ASSERT_FALSE(etag.empty());
+
+  boost::asio::write(socket, boost::asio::buffer("GET /test_cached/first HTTP/1.1\r\nHost: localhost\r\nIf-None-Match: " + etag + "\r\n\r\n"));
+  response = {};
+  beast_http::read(socket, buffer, response);
+  ASSERT_EQ(response.result(), beast_http::status::not_modified);
+  ASSERT_TRUE(response.body().empty());
+  ASSERT_EQ(*calls, 2);
+}
+
+TEST_F(HttpServerTest, RateLimit)
+{
+  namespace beast_http = boost::beast::http;
+
+  auto calls = std::make_shared<std::atomic<int>>(0);
+
+  http::RouteOptions options;
+  options.rateLimit = http::RateLimitOptions{};
+  options.rateLimit->rate = 0.1;
+  options.rateLimit->burst = 2;
+  options.rateLimit->header = "X-Api-Key";
+  GetServer()->AddRequestHandler("/test_limited", beast_http::verb::get, [calls](const http::HttpRequest& request)
+      {
+        ++*calls;
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "limited");
+      }, options);
+
+  const auto get = [](const std::string& headers)
+  {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::socket socket{io};
+    socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), TestEnvironment::GetPort()});
+    boost::asio::write(socket, boost::asio::buffer("GET /test_limited HTTP/1.1\r\nHost: localhost\r\n" + headers + "\r\n"));
+
+    boost::beast::flat_buffer buffer;
+    http::HttpResponse response;
+    beast_http::read(socket, buffer, response);
+    return response;
+  };
+
+  ASSERT_EQ(get("").result(), beast_http::status::ok);
+  ASSERT_EQ(get("").result(), beast_http::status::ok);
+
+  // the burst of the address is spent, the handler isn't called
+  const auto response = get("");
+  ASSERT_EQ(response.result(), beast_http::status::too_many_requests);
+  ASSERT_EQ(response[beast_http::field::retry_after], "10");
+  ASSERT_EQ(*calls, 2);
+
+  // the value of the header doesn't bypass the limit of the address
+  ASSERT_EQ(get("X-Api-Key: first\r\n").result(), beast_http::status::too_many_requests);
+  ASSERT_EQ(*calls, 2);
+}
+
+TEST_F(HttpServerTest, CoalescedRequests)
+{
+  namespace beast_http = boost::beast::http;
+
+  std::mutex m;
+  std::vector<std::pair<std::string, http::Responder>> held;
+
+  http::RouteOptions options;
+  options.coalesce = http::CoalesceOptions{};
+  GetServer()->AddRequestHandler("/test_coalesced", beast_http::verb::get,
+      [&m, &held](const http::HttpRequest& request, http::Responder responder)
+      {
+        std::lock_guard<std::mutex> lock{m};
+        held.emplace_back(std::string(request.target()), std::move(responder));
+      }, options);
+
+  const auto calls = [&m, &held]
+  {
+    std::lock_guard<std::mutex> lock{m};
+    return held.size();
+  };
+
+  boost::asio::io_context io;
+  std::vector<boost::asio::ip::tcp::socket> sockets;
+  for (const auto* target : {"/test_coalesced?q=1", "/test_coalesced?q=1", "/test_coalesced?q=1", "/test_coalesced?q=2"})
+  {
+    sockets.emplace_back(io);
+    sockets.back().connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), TestEnvironment::GetPort()});
+    boost::asio::write(sockets.back(), boost::asio::buffer("GET " + std::string(target) + " HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+  }
+
+  // the identical requests wait for one call of the handler
+  for (int i = 0; i < 200 && GetServer()->GetStats().requests < 4; i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(calls(), 2u);
+
+  {
+    std::lock_guard<std::mutex> lock{m};
+    for (auto& [target, responder] : held)
+    {
+      responder(http::MakeResponse(http::HttpRequest{}, beast_http::status::ok, "text/plain", "UTF-8", target));
+    }
+    held.clear();
+  }
+
+  for (std::size_t i = 0; i < sockets.size(); i++)
+  {
+    boost::beast::flat_buffer buffer;
+    http::HttpResponse response;
+    beast_http::read(sockets[i], buffer, response);
+    ASSERT_EQ(response.result(), beast_http::status::ok);
+    ASSERT_EQ(response.body(), i < 3 ? "/test_coalesced?q=1" : "/test_coalesced?q=2");
+  }
+
+  // the finished flight isn't joined by the next request
+  boost::asio::write(sockets.front(), boost::asio::buffer(std::string{"GET /test_coalesced?q=1 HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+  for (int i = 0; i < 200 && !calls(); i++)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(calls(), 1u);
+  {
+    std::lock_guard<std::mutex> lock{m};
+    held.front().second(http::MakeResponse(http::HttpRequest{}, beast_http::status::ok, "text/plain", "UTF-8", "again"));
+    held.clear();
+  }
+
+  boost::beast::flat_buffer buffer;
+  http::HttpResponse response;
+  beast_http::read(sockets.front(), buffer, response);
+  ASSERT_EQ(response.body(), "again");
+}
+
+TEST_F(HttpServerTest, StaticFiles)
+{
+  namespace beast_http = boost::beast::http;
+
+  const auto root = fs::temp_directory_path() / ("cmntype_server_static_" + std::to_string(TestEnvironment::GetPort()));
+  fs::create_directories(root);
+
+  std::string content(3 * 1024 * 1024 + 7, '\0');
+  for (std::size_t i = 0; i < content.size(); i++)
+  {
+    content[i] = static_cast<char>('a' + i % 26);
+  }
+  {
+    std::ofstream file{(root / "data.bin").string(), std::ios::binary};
+    file << content;
+  }
+
+  GetServer()->AddStaticFiles("/test_static/", root);
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), TestEnvironment::GetPort()});
+
+  const auto request = [&socket](const std::string& headers)
+  {
+    const auto text = "GET /test_static/data.bin HTTP/1.1\r\nHost: localhost\r\n" + headers + "\r\n";
+    boost::asio::write(socket, boost::asio::buffer(text));
+  };
+
+  boost::beast::flat_buffer buffer;
+  http::HttpResponse response;
+
+  request("");
+  beast_http::response_parser<beast_http::string_body> parser;
+  parser.body_limit(content.size());
+  beast_http::read(socket, buffer, parser);
+  response = parser.release();
+  ASSERT_EQ(response.result(), beast_http::status::ok);
+  ASSERT_TRUE(response.body() == content);
+
+  const auto etag = std::string(response[beast_http::field::etag]);
+
+  request("Range: bytes=1000-1999\r\n");
+  response = {};
+  beast_http::read(socket, buffer, response);
+  ASSERT_EQ(response.result(), beast_http::status::partial_content);
+  ASSERT_EQ(response.body(), content.substr(1000, 1000));
+
+  request("If-None-Match: " + etag + "\r\n");
+  response = {};
+  beast_http::read(socket, buffer, response);
+  ASSERT_EQ(response.result(), beast_http::status::not_modified);
+
+  auto& curl = GetCurl();
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % TestEnvironment::GetPort() % "/test_static/missing").str();
+  ASSERT_EQ(std::get<1>(curl.Get(url, "")), static_cast<long>(beast_http::status::not_found));
+
+  fs::remove_all(root);
+}
+
+TEST(HttpServer, PerThreadMode)
+{
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 1;
+  constexpr std::uint16_t threads = 2;
+
+  http::Configuration config;
+  config.threading = http::Configuration::Threading::per_thread;
+
+  std::mutex m;
+  std::set<std::thread::id> ids;
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, threads, config};
+  server.AddRequestHandler(resource, boost::beast::http::verb::get, [&m, &ids](const http::HttpRequest& request)
+      {
+        {
+          std::lock_guard<std::mutex> lock{m};
+          ids.insert(std::this_thread::get_id());
+        }
+
+        http::HttpResponse response{boost::beast::http::status::ok, request.version()};
+        response.body() = "per thread";
+        response.prepare_payload();
+        return response;
+      });
+  server.Start();
+
+  auto url = (boost::format("http://%1%:%2%%3%") % TestEnvironment::GetIp() % port % resource.data()).str();
+  for (int i = 0; i < 4; i++)
+  {
+    curl::LibCurl curl;
+    auto response = curl.Get(url, "");
+    ASSERT_EQ(std::get<1>(response), static_cast<long>(boost::beast::http::status::ok));
+    ASSERT_EQ(std::get<0>(response), "per thread");
+  }
+
+  // the kernel spreads the connections over the listeners by the address of the client,
+  // the connections from the different ports are served by the different threads
+  boost::asio::io_context io;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+  for (int i = 0; i < 64; i++)
+  {
+    boost::asio::ip::tcp::socket socket{io};
+    socket.connect(endpoint);
+    boost::asio::write(socket, boost::asio::buffer("GET " + std::string(resource) + " HTTP/1.1\r\nHost: localhost\r\n\r\n"));
+
+    boost::beast::flat_buffer buffer;
+    http::HttpResponse response;
+    boost::beast::http::read(socket, buffer, response);
+    ASSERT_EQ(response.body(), "per thread");
+  }
+
+  server.Stop();
+  ASSERT_GT(ids.size(), 1u);
+  ASSERT_LE(ids.size(), static_cast<std::size_t>(threads));
+}
+
+TEST(HttpServer, AdmissionControl)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 2;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  http::Configuration config;
+  config.limits.connections = 1;
+  config.limits.requests = 1;
+  config.limits.retryAfter = std::chrono::seconds{3};
+
+  std::mutex m;
+  std::vector<http::Responder> held;
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2, config};
+  server.AddRequestHandler("/slow", beast_http::verb::get, [&m, &held](const http::HttpRequest&, http::Responder responder)
+      {
+        std::lock_guard<std::mutex> lock{m};
+        held.push_back(std::move(responder));
+      });
+  server.Start();
+
+  const auto wait = [&server](auto predicate)
+  {
+    for (int i = 0; i < 200 && !predicate(server.GetStats()); i++)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return predicate(server.GetStats());
+  };
+
+  // the second pipelined request exceeds the limit of the requests in flight
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket first{io};
+  first.connect(endpoint);
+  const std::string request{"GET /slow HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+  boost::asio::write(first, boost::asio::buffer(request + request));
+  ASSERT_TRUE(wait([](const http::ServerStats& stats) { return stats.requests == 1 && stats.rejectedRequests == 1; }));
+
+  // the second connection exceeds the limit of the connections
+  boost::asio::ip::tcp::socket second{io};
+  second.connect(endpoint);
+  boost::beast::flat_buffer buffer;
+  http::HttpResponse response;
+  beast_http::read(second, buffer, response);
+  ASSERT_EQ(response.result(), beast_http::status::service_unavailable);
+  ASSERT_EQ(response[beast_http::field::retry_after], "3");
+
+  auto stats = server.GetStats();
+  ASSERT_EQ(stats.connections, 1u);
+  ASSERT_EQ(stats.rejectedConnections, 1u);
+
+  {
+    std::lock_guard<std::mutex> lock{m};
+    ASSERT_EQ(held.size(), 1u);
+    held.front()(http::MakeResponse(http::HttpRequest{}, beast_http::status::ok, "text/plain", "UTF-8", "slow"));
+    held.clear();
+  }
+
+  buffer.clear();
+  response = {};
+  beast_http::read(first, buffer, response);
+  ASSERT_EQ(response.result(), beast_http::status::ok);
+
+  response = {};
+  beast_http::read(first, buffer, response);
+  ASSERT_EQ(response.result(), beast_http::status::service_unavailable);
+  ASSERT_EQ(response[beast_http::field::retry_after], "3");
+
+  first.close();
+  ASSERT_TRUE(wait([](const http::ServerStats& stats) { return stats.connections == 0 && stats.requests == 0; }));
+
+  server.Stop();
+}
+
+TEST(HttpServer, AdmissionPause)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 2;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  http::Configuration config;
+  config.limits.connections = 1;
+  config.limits.overload = http::Configuration::Limits::Overload::pause;
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2, config};
+  server.AddRequestHandler(resource, beast_http::verb::get, [](const http::HttpRequest& request)
+      {
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "paused");
+      });
+  server.Start();
+
+  const std::string request{"GET /test HTTP/1.1\r\nHost: localhost\r\n\r\n"};
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket first{io};
+  first.connect(endpoint);
+  boost::asio::write(first, boost::asio::buffer(request));
+
+  boost::beast::flat_buffer buffer;
+  http::HttpResponse response;
+  beast_http::read(first, buffer, response);
+  ASSERT_EQ(response.body(), "paused");
+
+  // the second connection waits in the backlog until the first one is closed
+  boost::asio::ip::tcp::socket second{io};
+  second.connect(endpoint);
+  boost::asio::write(second, boost::asio::buffer(request));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_GT(server.GetStats().pausedAccepts, 0u);
+  first.close();
+
+  buffer.clear();
+  response = {};
+  beast_http::read(second, buffer, response);
+  ASSERT_EQ(response.body(), "paused");
+  ASSERT_EQ(server.GetStats().rejectedConnections, 0u);
+
+  server.Stop();
+}
+
+TEST(HttpServer, Timeouts)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 3;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  http::Configuration config;
+  config.timeouts.header = std::chrono::milliseconds(100);
+  config.timeouts.idle = std::chrono::milliseconds(1000);
+  config.timeouts.resolution = std::chrono::milliseconds(20);
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2, config};
+  server.AddRequestHandler(resource, beast_http::verb::get, [](const http::HttpRequest& request)
+      {
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "timeouts");
+      });
+  server.Start();
+
+  boost::asio::io_context io;
+  boost::beast::flat_buffer buffer;
+  char byte = 0;
+
+  // the connection without the request is closed by the header timeout
+  boost::asio::ip::tcp::socket silent{io};
+  silent.connect(endpoint);
+  const auto start = std::chrono::steady_clock::now();
+  boost::system::error_code ec;
+  silent.read_some(boost::asio::buffer(&byte, 1), ec);
+  ASSERT_EQ(ec, boost::asio::error::eof);
+  ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(2));
+
+  // the keep-alive connection is closed by the idle timeout after the response
+  boost::asio::ip::tcp::socket idle{io};
+  idle.connect(endpoint);
+  boost::asio::write(idle, boost::asio::buffer(std::string{"GET /test HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+
+  http::HttpResponse response;
+  beast_http::read(idle, buffer, response);
+  ASSERT_EQ(response.body(), "timeouts");
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  boost::asio::write(idle, boost::asio::buffer(std::string{"GET /test HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+  response = {};
+  beast_http::read(idle, buffer, response);
+  ASSERT_EQ(response.body(), "timeouts");
+
+  idle.read_some(boost::asio::buffer(&byte, 1), ec);
+  ASSERT_EQ(ec, boost::asio::error::eof);
+
+  // the next request of the keep-alive connection is limited by the header timeout from its first byte
+  boost::asio::ip::tcp::socket slow{io};
+  slow.connect(endpoint);
+  boost::asio::write(slow, boost::asio::buffer(std::string{"GET /test HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+  response = {};
+  beast_http::read(slow, buffer, response);
+  ASSERT_EQ(response.body(), "timeouts");
+
+  boost::asio::write(slow, boost::asio::buffer(std::string{"GET /test HTTP/1.1\r\n"}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  boost::asio::write(slow, boost::asio::buffer(std::string{"Host: localhost\r\n\r\n"}), ec);
+  response = {};
+  beast_http::read(slow, buffer, response, ec);
+  ASSERT_TRUE(ec);
+
+  server.Stop();
+}
+
+TEST(HttpServer, Metrics)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 4;
+
+  http::Configuration config;
+  config.metrics.path = "/metrics";
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2, config};
+  server.AddRequestHandler(resource, beast_http::verb::get, [](const http::HttpRequest& request)
+      {
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "metrics");
+      });
+  server.Start();
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port});
+
+  boost::beast::flat_buffer buffer;
+  for (const auto target : {"/test", "/test", "/unknown", "/metrics", "/test"})
+  {
+    http::HttpRequest request{beast_http::verb::get, target, 11};
+    request.set(beast_http::field::host, "localhost");
+    beast_http::write(socket, request);
+
+    http::HttpResponse response;
+    beast_http::read(socket, buffer, response);
+
+    if (std::string_view{target} == "/metrics")
+    {
+      const auto& body = response.body();
+      ASSERT_EQ(response.result(), beast_http::status::ok);
+      ASSERT_NE(body.find(R"(http_requests_total{route="/test",method="GET",code="200"} 2)"), std::string::npos);
+      ASSERT_NE(body.find(R"(http_requests_total{route="unmatched",method="*",code="404"} 1)"), std::string::npos);
+      ASSERT_NE(body.find(R"(http_request_duration_seconds{route="/test",method="GET",quantile="0.99"})"), std::string::npos);
+      ASSERT_NE(body.find("http_connections 1"), std::string::npos);
+    }
+  }
+
+  // the scrape itself is recorded after its response is written, before the next response
+  ASSERT_NE(server.GetMetrics().find(R"(http_requests_total{route="/metrics",method="GET",code="200"} 1)"), std::string::npos);
+
+  server.Stop();
+}
+
+TEST(HttpServer, Drain)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 5;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  std::mutex m;
+  std::vector<std::thread> workers;
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2};
+  server.AddRequestHandler(resource, beast_http::verb::get, [&m, &workers](const http::HttpRequest& request, http::Responder responder)
+      {
+        std::lock_guard<std::mutex> lock{m};
+        workers.emplace_back([&request, responder]
+            {
+              std::this_thread::sleep_for(std::chrono::milliseconds(200));
+              responder(http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "drained"));
+            });
+      });
+  server.Start();
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect(endpoint);
+  boost::asio::write(socket, boost::asio::buffer(std::string{"GET /test HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+
+  // the request is in flight when the server is stopped
+  while (!server.GetStats().requests)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::thread stop{[&server] { server.Stop(); }};
+
+  boost::beast::flat_buffer buffer;
+  http::HttpResponse response;
+  beast_http::read(socket, buffer, response);
+  ASSERT_EQ(response.body(), "drained");
+  ASSERT_FALSE(response.keep_alive());
+
+  // the connection is closed after the response
+  char byte = 0;
+  boost::system::error_code ec;
+  socket.read_some(boost::asio::buffer(&byte, 1), ec);
+  ASSERT_EQ(ec, boost::asio::error::eof);
+
+  stop.join();
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+
+  // the new connections aren't accepted
+  boost::asio::ip::tcp::socket refused{io};
+  refused.connect(endpoint, ec);
+  ASSERT_TRUE(ec);
+}
+
+TEST(HttpServer, DrainStreams)
+{
+  namespace beast_http = boost::beast::http;
+  namespace websocket = boost::beast::websocket;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 11;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  std::mutex m;
+  std::optional<http::EventStream> stream;
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2};
+  server.AddEventStreamHandler("/events", [&m, &stream](const http::HttpRequest&, http::EventStream events)
+      {
+        events.Send("hello");
+        std::lock_guard<std::mutex> lock{m};
+        stream = std::move(events);
+      });
+  server.AddWebSocketHandler("/ws", http::WebSocketHandler{});
+  server.Start();
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect(endpoint);
+
+  http::HttpRequest request{beast_http::verb::get, "/events", 11};
+  request.set(beast_http::field::host, "localhost");
+  beast_http::write(socket, request);
+
+  boost::beast::flat_buffer buffer;
+  beast_http::response_parser<beast_http::string_body> parser;
+  beast_http::read_header(socket, buffer, parser);
+  while (parser.get().body().find("data: hello\n\n") == std::string::npos)
+  {
+    beast_http::read_some(socket, buffer, parser);
+  }
+
+  websocket::stream<boost::asio::ip::tcp::socket> client{io};
+  client.next_layer().connect(endpoint);
+  client.handshake("localhost", "/ws");
+
+  // the open stream isn't a request in flight, the drain doesn't wait for it
+  ASSERT_EQ(server.GetStats().requests, 0u);
+
+  std::thread stop{[&server] { server.Stop(); }};
+
+  // the event stream is completed by the last chunk
+  boost::system::error_code ec;
+  while (!parser.is_done() && !ec)
+  {
+    beast_http::read_some(socket, buffer, parser, ec);
+  }
+  ASSERT_FALSE(ec);
+  ASSERT_TRUE(parser.is_done());
+
+  // the connection is closed after the stream
+  char byte = 0;
+  socket.read_some(boost::asio::buffer(&byte, 1), ec);
+  ASSERT_EQ(ec, boost::asio::error::eof);
+
+  // the websocket is closed by the server with 'going away'
+  boost::beast::flat_buffer frames;
+  ec = {};
+  client.read(frames, ec);
+  ASSERT_EQ(ec, websocket::error::closed);
+  ASSERT_EQ(client.reason().code, websocket::close_code::going_away);
+
+  stop.join();
+  stream.reset();
+}
+
+TEST(HttpServer, Restart)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 6;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  std::mutex m;
+  std::optional<http::Responder> held;
+
+  http::Configuration config;
+  config.timeouts.drain = std::chrono::milliseconds(10);
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 4, config};
+  server.AddRequestHandler(resource, beast_http::verb::get, [](const http::HttpRequest& request)
+      {
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "restart");
+      });
+  server.AddRequestHandler("/test_held", beast_http::verb::get, [&m, &held](const http::HttpRequest&, http::Responder responder)
+      {
+        std::lock_guard<std::mutex> lock{m};
+        held = std::move(responder);
+      });
+
+  constexpr int count = 50;
+
+  for (int i = 0; i < count; i++)
+  {
+    server.Start();
+
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::socket socket{io};
+    socket.connect(endpoint);
+
+    http::HttpRequest request{beast_http::verb::get, "/test", 11};
+    request.set(beast_http::field::host, "localhost");
+    beast_http::write(socket, request);
+
+    boost::beast::flat_buffer buffer;
+    http::HttpResponse response;
+    beast_http::read(socket, buffer, response);
+    ASSERT_EQ(response.body(), "restart");
+
+    // the idle keep-alive connection doesn't delay the stop, it is closed by the stop
+    server.Stop();
+
+    char byte = 0;
+    boost::system::error_code ec;
+    socket.read_some(boost::asio::buffer(&byte, 1), ec);
+    ASSERT_TRUE(ec);
+  }
+
+  // the responder kept by the application outlives the stop, the session refers to the contexts of the server
+  server.Start();
+  {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::socket socket{io};
+    socket.connect(endpoint);
+    boost::asio::write(socket, boost::asio::buffer(std::string{"GET /test_held HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+
+    while ([&m, &held] { std::lock_guard<std::mutex> lock{m}; return !held; }())
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    server.Stop();
+
+    std::lock_guard<std::mutex> lock{m};
+    (*held)(http::MakeResponse(http::HttpRequest{}, beast_http::status::ok, "text/plain", "UTF-8", "late"));
+    held.reset();
+  }
+
+  // the reply of the previous run is completed by the closed connection, the server serves the new ones
+  server.Start();
+  {
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::socket socket{io};
+    socket.connect(endpoint);
+
+    http::HttpRequest request{beast_http::verb::get, "/test", 11};
+    request.set(beast_http::field::host, "localhost");
+    beast_http::write(socket, request);
+
+    boost::beast::flat_buffer buffer;
+    http::HttpResponse response;
+    beast_http::read(socket, buffer, response);
+    ASSERT_EQ(response.body(), "restart");
+  }
+  server.Stop();
+}
+
+TEST(HttpServer, WebSocket)
+{
+  namespace beast_http = boost::beast::http;
+  namespace websocket = boost::beast::websocket;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 7;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  auto channel = std::make_shared<http::WebSocketChannel>();
+  std::atomic<int> closed{0};
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2};
+
+  http::WebSocketHandler handler;
+  handler.onOpen = [channel](const http::HttpRequest&, const http::WebSocket& socket)
+      {
+        channel->Join(socket);
+      };
+  handler.onMessage = [](const http::WebSocket& socket, std::string_view message, bool text)
+      {
+        socket.Send("echo: " + std::string(message), text);
+      };
+  handler.onClose = [&closed](const http::WebSocket&)
+      {
+        closed++;
+      };
+  server.AddWebSocketHandler("/ws", std::move(handler));
+  server.Start();
+
+  boost::asio::io_context io;
+  constexpr std::size_t count = 3;
+  std::vector<std::unique_ptr<websocket::stream<boost::asio::ip::tcp::socket>>> clients;
+
+  for (std::size_t i = 0; i < count; i++)
+  {
+    auto client = std::make_unique<websocket::stream<boost::asio::ip::tcp::socket>>(io);
+    client->next_layer().connect(endpoint);
+    client->handshake("localhost", "/ws");
+    clients.push_back(std::move(client));
+  }
+
+  // echo of the message
+  boost::beast::flat_buffer buffer;
+  clients.front()->write(boost::asio::buffer(std::string{"hello"}));
+  clients.front()->read(buffer);
+  ASSERT_EQ(boost::beast::buffers_to_string(buffer.data()), "echo: hello");
+  buffer.clear();
+
+  // the broadcast is received by all connections
+  while (channel->Size() < count)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(channel->Publish("broadcast"), count);
+  for (auto& client : clients)
+  {
+    client->read(buffer);
+    ASSERT_EQ(boost::beast::buffers_to_string(buffer.data()), "broadcast");
+    buffer.clear();
+  }
+
+  // the closed connection leaves the channel
+  clients.back()->close(websocket::close_code::normal);
+  clients.pop_back();
+  while (closed < 1)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  ASSERT_EQ(channel->Publish("next"), count - 1);
+
+  // the request without the upgrade
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect(endpoint);
+  http::HttpRequest request{beast_http::verb::get, "/ws", 11};
+  request.set(beast_http::field::host, "localhost");
+  beast_http::write(socket, request);
+
+  http::HttpResponse response;
+  beast_http::read(socket, buffer, response);
+  ASSERT_EQ(response.result(), beast_http::status::upgrade_required);
+
+  server.Stop();
+}
+
+TEST(HttpServer, EventStream)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 8;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  auto channel = std::make_shared<http::EventChannel>();
+  std::mutex m;
+  std::optional<http::EventStream> stream;
+
+  http::EventStreamOptions options;
+  options.bufferLimit = 1024;
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2};
+  server.AddEventStreamHandler("/events", [channel, &m, &stream](const http::HttpRequest&, http::EventStream events)
+      {
+        events.Send("hello");
+        channel->Join(events);
+        std::lock_guard<std::mutex> lock{m};
+        stream = std::move(events);
+      }, options);
+  server.Start();
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect(endpoint);
+
+  http::HttpRequest request{beast_http::verb::get, "/events", 11};
+  request.set(beast_http::field::host, "localhost");
+  beast_http::write(socket, request);
+
+  boost::beast::flat_buffer buffer;
+  beast_http::response_parser<beast_http::string_body> parser;
+  parser.body_limit(std::numeric_limits<std::uint64_t>::max());
+  beast_http::read_header(socket, buffer, parser);
+  ASSERT_EQ(parser.get()[beast_http::field::content_type], "text/event-stream");
+
+  const auto wait = [&](std::string_view text)
+      {
+        while (parser.get().body().find(text) == std::string::npos && !parser.is_done())
+        {
+          beast_http::read_some(socket, buffer, parser);
+        }
+        return parser.get().body().find(text) != std::string::npos;
+      };
+
+  ASSERT_TRUE(wait("data: hello\n\n"));
+
+  // the events published from the other thread
+  std::thread publisher{[channel]
+      {
+        for (int i = 0; i < 10; i++)
+        {
+          channel->Publish("event " + std::to_string(i), "update", std::to_string(i));
+        }
+      }};
+  publisher.join();
+  ASSERT_TRUE(wait("id: 9\nevent: update\ndata: event 9\n\n"));
+
+  // the event over the buffer limit closes the stream
+  {
+    std::lock_guard<std::mutex> lock{m};
+    ASSERT_FALSE(stream->Send(std::string(4096, 'x')));
+    ASSERT_FALSE(stream->IsOpen());
+    ASSERT_EQ(channel->Publish("closed"), 0u);
+  }
+
+  wait("end of stream");
+  ASSERT_TRUE(parser.is_done());
+
+  server.Stop();
+
+  // the stream may outlive the stop, it refers to the session and must be released before the server
+  stream.reset();
+}
+
+TEST(HttpServer, EventStreamSlowClient)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 14;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  // the events exceed the buffers of the sockets, so the writes to the client, which doesn't read, are blocked
+  constexpr std::size_t eventSize = 16 * 1024;
+  constexpr std::size_t count = 1024;
+  const std::string data(eventSize, 'x');
+
+  std::mutex m;
+  std::vector<http::EventStream> streams;
+  const auto handler = [&m, &streams](const http::HttpRequest&, http::EventStream events)
+      {
+        std::lock_guard<std::mutex> lock{m};
+        streams.push_back(std::move(events));
+      };
+  const auto opened = [&m, &streams](std::size_t size)
+      {
+        while (true)
+        {
+          {
+            std::lock_guard<std::mutex> lock{m};
+            if (streams.size() >= size)
+            {
+              return streams.back();
+            }
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      };
+
+  http::EventStreamOptions options;
+  options.bufferLimit = 2 * count * eventSize;
+  http::EventStreamOptions limited;
+  limited.bufferLimit = 4 * eventSize;
+
+  http::Configuration config;
+  config.limits.streams = 2;
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2, config};
+  server.AddEventStreamHandler("/events", handler, options);
+  server.AddEventStreamHandler("/limited", handler, limited);
+  server.Start();
+
+  boost::asio::io_context io;
+  const auto connect = [&endpoint](boost::asio::ip::tcp::socket& socket, const char* target)
+      {
+        socket.open(endpoint.protocol());
+        socket.set_option(boost::asio::socket_base::receive_buffer_size(4096));
+        socket.connect(endpoint);
+
+        http::HttpRequest request{beast_http::verb::get, target, 11};
+        request.set(beast_http::field::host, "localhost");
+        beast_http::write(socket, request);
+      };
+
+  boost::asio::ip::tcp::socket slow{io};
+  connect(slow, "/events");
+  const auto slowStream = opened(1);
+
+  boost::asio::ip::tcp::socket overflow{io};
+  connect(overflow, "/limited");
+  const auto limitedStream = opened(2);
+
+  // the streams are counted by their limit, they aren't requests in flight
+  ASSERT_EQ(server.GetStats().streams, 2u);
+  ASSERT_EQ(server.GetStats().requests, 0u);
+
+  boost::beast::flat_buffer buffer;
+  {
+    boost::asio::ip::tcp::socket rejected{io};
+    connect(rejected, "/events");
+    http::HttpResponse response;
+    beast_http::read(rejected, buffer, response);
+    ASSERT_EQ(response.result(), beast_http::status::service_unavailable);
+    buffer.clear();
+  }
+
+  // the events are published by the other thread while the client doesn't read
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < count; i++)
+  {
+    expected += http::EventStream::Format(data, {}, std::to_string(i)).size();
+  }
+
+  std::atomic<std::size_t> sent{0};
+  std::thread{[&slowStream, &data, &sent]
+      {
+        for (std::size_t i = 0; i < count; i++)
+        {
+          sent += slowStream.Send(data, {}, std::to_string(i)) ? 1 : 0;
+        }
+      }}.join();
+  ASSERT_EQ(sent, count);
+
+  // the events waiting for the write are coalesced, the client gets fewer chunks than events
+  std::size_t chunks = 0;
+  auto onChunk = [&chunks](std::uint64_t size, boost::beast::string_view, boost::system::error_code&)
+      {
+        chunks += size ? 1 : 0;
+      };
+
+  beast_http::response_parser<beast_http::string_body> parser;
+  parser.body_limit(std::numeric_limits<std::uint64_t>::max());
+  parser.on_chunk_header(onChunk);
+  beast_http::read_header(slow, buffer, parser);
+  while (parser.get().body().size() < expected)
+  {
+    beast_http::read_some(slow, buffer, parser);
+  }
+  ASSERT_EQ(parser.get().body().size(), expected);
+  const auto last = http::EventStream::Format(data, {}, std::to_string(count - 1));
+  ASSERT_EQ(parser.get().body().compare(expected - last.size(), last.size(), last), 0);
+  ASSERT_LT(chunks, count);
+
+  // the stream of the slow client is closed when the buffer limit is exceeded
+  std::thread{[&limitedStream, &data, &sent]
+      {
+        sent = 0;
+        while (sent < count && limitedStream.Send(data))
+        {
+          sent++;
+        }
+      }}.join();
+  ASSERT_LT(sent, count);
+  ASSERT_FALSE(limitedStream.IsOpen());
+
+  boost::beast::flat_buffer limitedBuffer;
+  beast_http::response_parser<beast_http::string_body> limitedParser;
+  limitedParser.body_limit(std::numeric_limits<std::uint64_t>::max());
+  boost::system::error_code ec;
+  while (!limitedParser.is_done() && !ec)
+  {
+    beast_http::read_some(overflow, limitedBuffer, limitedParser, ec);
+  }
+  ASSERT_FALSE(ec);
+  ASSERT_TRUE(limitedParser.is_done());
+
+  server.Stop();
+  streams.clear();
+}
+
+/// @brief Write the self-signed certificate and its key (PEM)
+static void MakeCertificate(const fs::path& certificate, const fs::path& key)
+{
+  std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)> pkey{EVP_EC_gen("P-256"), EVP_PKEY_free};
+  ASSERT_TRUE(pkey);
+
+  std::unique_ptr<X509, decltype(&X509_free)> x509{X509_new(), X509_free};
+  X509_set_version(x509.get(), 2);
+  ASN1_INTEGER_set(X509_get_serialNumber(x509.get()), 1);
+  X509_gmtime_adj(X509_getm_notBefore(x509.get()), 0);
+  X509_gmtime_adj(X509_getm_notAfter(x509.get()), 3600);
+  X509_set_pubkey(x509.get(), pkey.get());
+
+  auto* name = X509_get_subject_name(x509.get());
+  X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0);
+  X509_set_issuer_name(x509.get(), name);
+  ASSERT_GT(X509_sign(x509.get(), pkey.get(), EVP_sha256()), 0);
+
+  std::unique_ptr<BIO, decltype(&BIO_free)> certificateFile{BIO_new_file(certificate.string().c_str(), "w"), BIO_free};
+  ASSERT_TRUE(certificateFile);
+  ASSERT_EQ(PEM_write_bio_X509(certificateFile.get(), x509.get()), 1);
+
+  std::unique_ptr<BIO, decltype(&BIO_free)> keyFile{BIO_new_file(key.string().c_str(), "w"), BIO_free};
+  ASSERT_TRUE(keyFile);
+  ASSERT_EQ(PEM_write_bio_PrivateKey(keyFile.get(), pkey.get(), nullptr, nullptr, 0, nullptr, nullptr), 1);
+}
+
+TEST(HttpServer, Tls)
+{
+  namespace beast_http = boost::beast::http;
+  namespace ssl = boost::asio::ssl;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 9;
+  const boost::asio::ip::tcp::endpoint endpoint{boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port};
+
+  const auto dir = fs::temp_directory_path() / ("cmntype_tls_" + std::to_string(::getpid()));
+  fs::create_directories(dir);
+  MakeCertificate(dir / "certificate.pem", dir / "key.pem");
+
+  http::Configuration config;
+  config.tls.enabled = true;
+  config.tls.certificate = (dir / "certificate.pem").string();
+  config.tls.privateKey = (dir / "key.pem").string();
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2, config};
+  server.AddRequestHandler(resource, beast_http::verb::get, [](const http::HttpRequest& request)
+      {
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", "secure");
+      });
+  server.Start();
+
+  boost::asio::io_context io;
+  ssl::context client{ssl::context::tls_client};
+  client.set_verify_mode(ssl::verify_none);
+
+  SSL_SESSION* session = nullptr;
+
+  // request by the new connection, the session is resumed if it is given
+  const auto get = [&](SSL_SESSION* resumed)
+      {
+        boost::beast::ssl_stream<boost::beast::tcp_stream> stream{io, client};
+        stream.next_layer().connect(endpoint);
+        if (resumed)
+        {
+          SSL_set_session(stream.native_handle(), resumed);
+        }
+        stream.handshake(ssl::stream_base::client);
+
+        http::HttpRequest request{beast_http::verb::get, resource.data(), 11};
+        request.set(beast_http::field::host, "localhost");
+        beast_http::write(stream, request);
+
+        boost::beast::flat_buffer buffer;
+        http::HttpResponse response;
+        beast_http::read(stream, buffer, response);
+        EXPECT_EQ(response.body(), "secure");
+
+        const bool reused = SSL_session_reused(stream.native_handle()) == 1;
+        if (!session)
+        {
+          session = SSL_get1_session(stream.native_handle());
+        }
+
+        boost::beast::error_code ec;
+        stream.shutdown(ec);
+        return reused;
+      };
+
+  ASSERT_FALSE(get(nullptr));
+  ASSERT_NE(session, nullptr);
+  ASSERT_TRUE(get(session));
+  SSL_SESSION_free(session);
+
+  // the plain request isn't answered by the TLS listener
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect(endpoint);
+  http::HttpRequest request{beast_http::verb::get, resource.data(), 11};
+  request.set(beast_http::field::host, "localhost");
+  beast_http::write(socket, request);
+
+  boost::beast::flat_buffer buffer;
+  http::HttpResponse response;
+  boost::beast::error_code ec;
+  beast_http::read(socket, buffer, response, ec);
+  ASSERT_TRUE(ec);
+
+  server.Stop();
+  fs::remove_all(dir);
+}
+
+TEST(HttpServer, ResponseTemplate)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 10;
+
+  const auto health = http::MakeResponseTemplate(beast_http::status::ok, "text/plain", "UTF-8", "healthy");
+
+  http::HttpServer server{TestEnvironment::GetIp(), port, 2};
+  server.AddResponse("/health", beast_http::verb::get, health);
+  server.AddResponse("/health", beast_http::verb::head, health);
+  server.Start();
+
+  boost::asio::io_context io;
+  boost::asio::ip::tcp::socket socket{io};
+  socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port});
+
+  boost::beast::flat_buffer buffer;
+  const auto get = [&](beast_http::verb method, std::string_view target, unsigned version)
+      {
+        http::HttpRequest request{method, boost::beast::string_view{target.data(), target.size()}, version};
+        request.set(beast_http::field::host, "localhost");
+        beast_http::write(socket, request);
+
+        beast_http::response_parser<beast_http::string_body> parser;
+        parser.skip(method == beast_http::verb::head);
+        beast_http::read(socket, buffer, parser);
+        return parser.release();
+      };
+
+  auto response = get(beast_http::verb::get, "/health", 11);
+  ASSERT_EQ(response.result(), beast_http::status::ok);
+  ASSERT_EQ(response.body(), "healthy");
+  ASSERT_TRUE(response.keep_alive());
+
+  response = get(beast_http::verb::head, "/health", 11);
+  ASSERT_EQ(response.result(), beast_http::status::ok);
+  ASSERT_EQ(response[beast_http::field::content_length], "7");
+  ASSERT_TRUE(response.body().empty());
+
+  response = get(beast_http::verb::get, "/unknown", 11);
+  ASSERT_EQ(response.result(), beast_http::status::not_found);
+  ASSERT_EQ(response.body(), "not found");
+
+  response = get(beast_http::verb::post, "/health", 11);
+  ASSERT_EQ(response.result(), beast_http::status::method_not_allowed);
+
+  // the request of HTTP/1.0 closes the connection
+  response = get(beast_http::verb::get, "/health", 10);
+  ASSERT_EQ(response.body(), "healthy");
+  ASSERT_FALSE(response.keep_alive());
+
+  boost::beast::error_code ec;
+  beast_http::response<beast_http::string_body> next;
+  beast_http::read(socket, buffer, next, ec);
+  ASSERT_EQ(ec, beast_http::error::end_of_stream);
+
+  server.Stop();
+}
+
+TEST(HttpServer, CompressedResponse)
+{
+  namespace beast_http = boost::beast::http;
+
+  constexpr std::uint16_t port = TestEnvironment::GetPort() + 13;
+
+  const std::string body(64 * 1024, 'z');
+  const auto handler = [body](const http::HttpRequest& request)
+      {
+        return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", body);
+      };
+
+  // the compression is opt-in, the default server sends the body as is
+  http::Configuration config;
+  for (const auto enabled : {false, true})
+  {
+    config.compression.enabled = enabled;
+
+    http::RouteOptions options;
+    options.cacheable = true;
+    http::HttpServer server{TestEnvironment::GetIp(), port, 1, config};
+    server.AddRequestHandler("/test_compressed", beast_http::verb::get, handler, options);
+    http::RouteOptions cached;
+    cached.cache = http::CacheOptions{};
+    server.AddRequestHandler("/test_compressed_cached", beast_http::verb::get, handler, cached);
+    server.Start();
+
+    boost::asio::io_context io;
+    boost::asio::ip::tcp::socket socket{io};
+    socket.connect({boost::asio::ip::make_address(TestEnvironment::GetIp().data()), port});
+
+    boost::asio::write(socket, boost::asio::buffer(std::string{
+          "GET /test_compressed HTTP/1.1\r\nHost: localhost\r\nAccept-Encoding: gzip\r\n\r\n"
+          "GET /test_compressed HTTP/1.1\r\nHost: localhost\r\n\r\n"}));
+
+    boost::beast::flat_buffer buffer;
+    http::HttpResponse response;
+    beast_http::read(socket, buffer, response);
+    ASSERT_EQ(response.result(), beast_http::status::ok);
+    if (enabled)
+    {
+      ASSERT_EQ(response[beast_http::field::content_encoding], "gzip");
+      ASSERT_LT(response.body().size(), body.size() / 10);
+    }
+    else
+    {
+      ASSERT_EQ(response.body(), body);
+    }
+
+    response = {};
+    beast_http::read(socket, buffer, response);
+    ASSERT_EQ(response.body(), body);
+
+    // the hit of the response cache is compressed as the response of the handler
+    boost::asio::write(socket, boost::asio::buffer(std::string{
+          "GET /test_compressed_cached HTTP/1.1\r\nHost: localhost\r\nAccept-Encoding: gzip\r\n\r\n"
+          "GET /test_compressed_cached HTTP/1.1\r\nHost: localhost\r\nAccept-Encoding: gzip\r\n\r\n"}));
+
+    http::HttpResponse handled;
+    beast_http::read(socket, buffer, handled);
+    response = {};
+    beast_http::read(socket, buffer, response);
+    ASSERT_EQ(response.body(), handled.body());
+    ASSERT_EQ(response[beast_http::field::content_encoding], handled[beast_http::field::content_encoding]);
+    ASSERT_EQ(response[beast_http::field::etag], handled[beast_http::field::etag]);
+    if (enabled)
+    {
+      ASSERT_EQ(response[beast_http::field::content_encoding], "gzip");
+    }
+
+    server.Stop();
+  }
+}
+
+TEST(HttpServer, IoBackend)
+{
+  using IoBackend = http::Configuration::IoBackend;
+
+  const auto built = http::HttpServer::GetIoBackend();
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+  ASSERT_EQ(built, IoBackend::io_uring);
+#else
+  ASSERT_EQ(built, IoBackend::epoll);
+#endif
+
+  http::Configuration config;
+  for (const auto backend : {IoBackend::automatic, built})
+  {
+    config.ioBackend = backend;
+    ASSERT_NO_THROW(http::HttpServer(TestEnvironment::GetIp(), TestEnvironment::GetPort() + 12, 1, config));
+  }
+
+  // the other backend isn't built
+  config.ioBackend = IoBackend::epoll == built ? IoBackend::io_uring : IoBackend::epoll;
+  ASSERT_THROW(http::HttpServer(TestEnvironment::GetIp(), TestEnvironment::GetPort() + 12, 1, config), error::Error);
+}
+
 }
 }
@@ -0,0 +1,116 @@
+//! @file test_metrics.cpp
+//! @brief Define module test for metrics of the routes
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <cmntype/http/metrics.h>
+
+namespace http = common::http;
+
+TEST(Metrics, Histogram)
+{
+  // the buckets are contiguous and grow by the power of two
+  for (std::uint64_t value = 0; value < 100000; value++)
+  {
+    const auto index = http::Histogram::Index(value);
+    ASSERT_LT(value, http::Histogram::Upper(index));
+    ASSERT_TRUE(index == 0 || value >= http::Histogram::Upper(index - 1));
+  }
+  ASSERT_EQ(http::Histogram::Index(std::numeric_limits<std::uint64_t>::max()), http::Histogram::size - 1);
+
+  http::Histogram histogram;
+  ASSERT_EQ(histogram.Quantile(0.99), 0u);
+
+  for (std::uint64_t value = 1; value <= 1000; value++)
+  {
+    histogram.Add(http::Histogram::Index(value), 1);
+  }
+  ASSERT_EQ(histogram.Count(), 1000u);
+
+  for (const auto [q, expected] : {std::pair{0.5, 500.0}, std::pair{0.99, 990.0}, std::pair{1.0, 1000.0}})
+  {
+    const auto value = static_cast<double>(histogram.Quantile(q));
+    ASSERT_NEAR(value, expected, expected * 0.125);
+  }
+
+  // the merged histogram has the quantiles of the union
+  http::Histogram upper;
+  for (std::uint64_t value = 1001; value <= 2000; value++)
+  {
+    upper.Add(http::Histogram::Index(value), 1);
+  }
+  histogram.Merge(upper);
+  ASSERT_EQ(histogram.Count(), 2000u);
+  ASSERT_NEAR(static_cast<double>(histogram.Quantile(0.5)), 1000.0, 1000.0 * 0.125);
+  ASSERT_NEAR(static_cast<double>(histogram.Quantile(0.99)), 1980.0, 1980.0 * 0.125);
+}
+
+TEST(Metrics, Route)
+{
+  http::Metrics metrics;
+  auto route = metrics.Route("/geo/{id}", boost::beast::http::verb::get);
+  ASSERT_EQ(route, metrics.Route("/geo/{id}", boost::beast::http::verb::get));
+  ASSERT_NE(route, metrics.Route("/geo/{id}", boost::beast::http::verb::post));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back([&route]
+        {
+          for (int j = 0; j < 1000; j++)
+          {
+            route->Record(j % 10 ? 200 : 404, std::chrono::milliseconds(j % 100), 100, 1000);
+          }
+        });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  const auto snapshot = route->Get();
+  ASSERT_EQ(snapshot.latency.Count(), 4000u);
+  ASSERT_EQ(snapshot.bytesIn, 400000u);
+  ASSERT_EQ(snapshot.bytesOut, 4000000u);
+  ASSERT_EQ(snapshot.statuses.at(200), 3600u);
+  ASSERT_EQ(snapshot.statuses.at(404), 400u);
+  ASSERT_NEAR(static_cast<double>(snapshot.latency.Quantile(0.99)), 99000.0, 99000.0 * 0.125);
+
+  metrics.Unmatched().Record(404, std::chrono::microseconds(10), 10, 10);
+
+  const auto text = metrics.Format(http::ServerStats{});
+  ASSERT_NE(text.find(R"(http_requests_total{route="/geo/{id}",method="GET",code="200"} 3600)"), std::string::npos);
+  ASSERT_NE(text.find(R"(http_request_duration_seconds_count{route="/geo/{id}",method="GET"} 4000)"), std::string::npos);
+  ASSERT_NE(text.find(R"(http_request_duration_seconds{route="/geo/{id}",method="GET",quantile="0.99"})"), std::string::npos);
+  ASSERT_NE(text.find(R"(http_requests_total{route="unmatched",method="*",code="404"} 1)"), std::string::npos);
+  ASSERT_NE(text.find("http_connections 0"), std::string::npos);
+  // the route without the requests isn't exposed
+  ASSERT_EQ(text.find(R"(method="POST")"), std::string::npos);
+}
+
+TEST(Metrics, Statuses)
+{
+  http::Metrics metrics;
+  auto route = metrics.Route("/geo", boost::beast::http::verb::get);
+
+  // the statuses beyond the slots of the shard are counted by the class
+  for (unsigned status = 500; status < 540; status++)
+  {
+    route->Record(status, std::chrono::microseconds(10), 10, 10);
+  }
+  route->Record(700, std::chrono::microseconds(10), 10, 10);
+
+  const auto snapshot = route->Get();
+  ASSERT_EQ(snapshot.latency.Count(), 41u);
+  ASSERT_EQ(snapshot.statuses.size(), 16u);
+  ASSERT_EQ(snapshot.statuses.at(500), 1u);
+  ASSERT_EQ(snapshot.classes[4], 24u);
+
+  const auto text = metrics.Format(http::ServerStats{});
+  ASSERT_NE(text.find(R"(http_requests_total{route="/geo",method="GET",code="5xx"} 24)"), std::string::npos);
+}
@@ -0,0 +1,144 @@
+//! @file test_rate_limiter.cpp
+//! @brief Define module test for rate limiter of the clients
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <cmntype/http/rate_limiter.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+TEST(RateLimiter, Key)
+{
+  http::RateLimitOptions options;
+  options.header = "X-Api-Key";
+  http::RateLimiter limiter{options};
+
+  const auto first = boost::asio::ip::make_address("127.0.0.1");
+  const auto second = boost::asio::ip::make_address("::1");
+
+  ASSERT_EQ(limiter.Key(first), limiter.Key(first));
+  ASSERT_NE(limiter.Key(first), limiter.Key(second));
+
+  http::HttpRequestHeader header;
+  ASSERT_EQ(limiter.Key(header), 0u);
+  header.set("X-Api-Key", "secret");
+  ASSERT_NE(limiter.Key(header), 0u);
+  ASSERT_NE(limiter.Key(header), limiter.Key(first));
+}
+
+TEST(RateLimiter, HeaderAndAddress)
+{
+  http::RateLimitOptions options;
+  options.rate = 1.0;
+  options.burst = 2;
+  options.header = "X-Api-Key";
+  http::RateLimiter limiter{options};
+
+  const auto first = boost::asio::ip::make_address("127.0.0.1");
+  const auto second = boost::asio::ip::make_address("::1");
+  const auto now = http::RateLimiter::Clock::now();
+
+  // the client changing the value of the header is limited by its address
+  for (int i = 0; i < 2; i++)
+  {
+    http::HttpRequestHeader header;
+    header.set("X-Api-Key", "random " + std::to_string(i));
+    ASSERT_EQ(limiter.Acquire(header, first, now).count(), 0);
+  }
+  http::HttpRequestHeader header;
+  header.set("X-Api-Key", "random");
+  ASSERT_NE(limiter.Acquire(header, first, now).count(), 0);
+
+  // the requests with the same value share the bucket whatever the address is
+  header.set("X-Api-Key", "secret");
+  ASSERT_EQ(limiter.Acquire(header, second, now).count(), 0);
+  ASSERT_EQ(limiter.Acquire(header, boost::asio::ip::make_address("10.0.0.1"), now).count(), 0);
+  ASSERT_NE(limiter.Acquire(header, boost::asio::ip::make_address("10.0.0.2"), now).count(), 0);
+}
+
+TEST(RateLimiter, Burst)
+{
+  http::RateLimitOptions options;
+  options.rate = 10.0;
+  options.burst = 3;
+  http::RateLimiter limiter{options};
+
+  const auto now = http::RateLimiter::Clock::now();
+  for (int i = 0; i < 3; i++)
+  {
+    ASSERT_EQ(limiter.Acquire(1, now).count(), 0);
+  }
+
+  // the next token is added in 100 ms
+  const auto wait = limiter.Acquire(1, now);
+  ASSERT_EQ(std::chrono::round<std::chrono::milliseconds>(wait).count(), 100);
+  ASSERT_EQ(limiter.Rejected(), 1u);
+
+  // the other client has own bucket
+  ASSERT_EQ(limiter.Acquire(2, now).count(), 0);
+
+  ASSERT_EQ(limiter.Acquire(1, now + std::chrono::milliseconds(100)).count(), 0);
+  ASSERT_NE(limiter.Acquire(1, now + std::chrono::milliseconds(100)).count(), 0);
+  ASSERT_EQ(limiter.Size(), 2u);
+}
+
+TEST(RateLimiter, Evict)
+{
+  http::RateLimitOptions options;
+  options.rate = 1.0;
+  options.burst = 1;
+  options.clients = 4;
+  http::RateLimiter limiter{options};
+
+  // the table is one shard of 4 slots, the stale clients are replaced
+  const auto now = http::RateLimiter::Clock::now();
+  for (std::uint64_t key = 1; key <= 16; key++)
+  {
+    ASSERT_EQ(limiter.Acquire(key, now + std::chrono::seconds(key)).count(), 0);
+  }
+  ASSERT_EQ(limiter.Size(), 4u);
+
+  // the recent client is still tracked
+  ASSERT_NE(limiter.Acquire(16, now + std::chrono::seconds(16)).count(), 0);
+}
+
+TEST(RateLimiter, Concurrent)
+{
+  http::RateLimitOptions options;
+  options.rate = 1e-3;
+  options.burst = 100;
+  http::RateLimiter limiter{options};
+
+  std::atomic<int> admitted{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++)
+  {
+    threads.emplace_back([&limiter, &admitted]
+        {
+          for (int j = 0; j < 1000; j++)
+          {
+            if (!limiter.Acquire(42, http::RateLimiter::Clock::now()).count())
+            {
+              admitted++;
+            }
+          }
+        });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  ASSERT_EQ(admitted, 100);
+  ASSERT_EQ(limiter.Rejected(), 3900u);
+}
@@ -0,0 +1,103 @@
+//! @file test_response_cache.cpp
+//! @brief Define module test for cache of the responses
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <cmntype/http/http_response.h>
+#include <cmntype/http/response_cache.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+http::HttpRequest MakeRequest(std::string_view target, std::string_view language = {})
+{
+  http::HttpRequest request{beast_http::verb::get, boost::beast::string_view{target.data(), target.size()}, 11};
+  if (!language.empty())
+  {
+    request.set(beast_http::field::accept_language, boost::beast::string_view{language.data(), language.size()});
+  }
+  return request;
+}
+}  // namespace
+
+TEST(ResponseCache, Key)
+{
+  http::CacheOptions options;
+  options.vary = {"Accept-Language"};
+  http::ResponseCache cache{options};
+
+  ASSERT_EQ(cache.Key(MakeRequest("/geo?id=1")), cache.Key(MakeRequest("/geo?id=1")));
+  ASSERT_NE(cache.Key(MakeRequest("/geo?id=1")), cache.Key(MakeRequest("/geo?id=2")));
+  ASSERT_NE(cache.Key(MakeRequest("/geo", "en")), cache.Key(MakeRequest("/geo", "ru")));
+}
+
+TEST(ResponseCache, StoreAndExpire)
+{
+  http::CacheOptions options;
+  options.ttl = std::chrono::milliseconds{50};
+  http::ResponseCache cache{options};
+
+  const auto request = MakeRequest("/geo");
+  const auto key = cache.Key(request);
+  ASSERT_EQ(cache.Find(key), nullptr);
+
+  auto response = http::MakeResponse(request, beast_http::status::ok, "application/json", "UTF-8", "{}");
+  ASSERT_TRUE(cache.Store(key, response));
+  // the validator is the digest of the body, it is the same in the other processes
+  ASSERT_EQ(response[beast_http::field::etag], "\"44136fa355b3678a1146ad16f7e8649e\"");
+
+  const auto cached = cache.Find(key);
+  ASSERT_NE(cached, nullptr);
+  ASSERT_EQ(cached->body(), "{}");
+  ASSERT_EQ((*cached)[beast_http::field::etag], response[beast_http::field::etag]);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{60});
+  ASSERT_EQ(cache.Find(key), nullptr);
+  ASSERT_EQ(cache.Size(), 0u);
+
+  // the errors and 'no-store' responses aren't cached
+  auto error = http::MakeResponseForServerError(request, "application/json", "UTF-8", "{}");
+  ASSERT_FALSE(cache.Store(key, error));
+  response.set(beast_http::field::cache_control, "no-store");
+  ASSERT_FALSE(cache.Store(key, response));
+
+  // the responses of the client aren't shared
+  response.set(beast_http::field::cache_control, "private, max-age=60");
+  ASSERT_FALSE(cache.Store(key, response));
+  response.erase(beast_http::field::cache_control);
+  response.set(beast_http::field::set_cookie, "session=1");
+  ASSERT_FALSE(cache.Store(key, response));
+  ASSERT_EQ(cache.Size(), 0u);
+}
+
+TEST(ResponseCache, Evict)
+{
+  http::CacheOptions options;
+  options.ttl = std::chrono::minutes{1};
+  options.maxSize = 8 * 1024;
+  http::ResponseCache cache{options};
+
+  // the limit of the shard is 1 KiB, so the shard keeps one response
+  const std::string body(700, 'x');
+  for (int i = 0; i < 64; i++)
+  {
+    const auto request = MakeRequest("/geo/" + std::to_string(i));
+    auto response = http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", body);
+    ASSERT_TRUE(cache.Store(cache.Key(request), response));
+  }
+  ASSERT_LE(cache.Size(), 8u);
+
+  const auto request = MakeRequest("/geo/63");
+  ASSERT_NE(cache.Find(cache.Key(request)), nullptr);
+
+  auto large = http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", std::string(2048, 'x'));
+  ASSERT_FALSE(cache.Store(cache.Key(request), large));
+}
@@ -0,0 +1,59 @@
+//! @file test_response_template.cpp
+//! @brief Define module test for template of the constant response
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+#include <gtest/gtest.h>
+
+#include <cmntype/http/response_template.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+std::string ToString(boost::asio::const_buffer buffer)
+{
+  return std::string{static_cast<const char*>(buffer.data()), buffer.size()};
+}
+}  // namespace
+
+TEST(ResponseTemplate, Header)
+{
+  const auto response = http::MakeResponseTemplate(beast_http::status::not_found, "application/json", "UTF-8", "not found");
+
+  ASSERT_EQ(response->Status(), 404u);
+  ASSERT_EQ(ToString(response->Body()), "not found");
+
+  const auto header = ToString(response->Header(11, true));
+  ASSERT_EQ(header.rfind("HTTP/1.1 404 Not Found\r\n", 0), 0u);
+  ASSERT_NE(header.find("Content-Type: application/json\r\n"), std::string::npos);
+  ASSERT_NE(header.find("Content-Length: 9\r\n"), std::string::npos);
+  ASSERT_EQ(header.find("Connection"), std::string::npos);
+  ASSERT_EQ(header.substr(header.size() - 4), "\r\n\r\n");
+
+  ASSERT_NE(ToString(response->Header(11, false)).find("Connection: close\r\n"), std::string::npos);
+  ASSERT_NE(ToString(response->Header(10, true)).find("Connection: keep-alive\r\n"), std::string::npos);
+  ASSERT_EQ(ToString(response->Header(10, false)).rfind("HTTP/1.0 404 Not Found\r\n", 0), 0u);
+
+  // the same buffer is returned for each request
+  ASSERT_EQ(response->Header(11, true).data(), response->Header(11, true).data());
+}
+
+TEST(ResponseTemplate, Make)
+{
+  http::HttpResponse source{beast_http::status::ok, 11};
+  source.set(beast_http::field::cache_control, "no-cache");
+  source.body() = "ok";
+  const http::ResponseTemplate response{std::move(source)};
+
+  ASSERT_NE(ToString(response.Header(11, true)).find("Cache-Control: no-cache\r\n"), std::string::npos);
+
+  http::HttpRequest request{beast_http::verb::get, "/health", 10};
+  const auto copy = response.Make(request);
+  ASSERT_EQ(copy.version(), 10u);
+  ASSERT_FALSE(copy.keep_alive());
+  ASSERT_EQ(copy.body(), "ok");
+  ASSERT_EQ(copy[beast_http::field::content_length], "2");
+}
@@ -0,0 +1,179 @@
+//! @file test_router.cpp
+//! @brief Define module test for router of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+#include <gtest/gtest.h>
+
+#include <cmntype/error/error.h>
+#include <cmntype/http/http_response.h>
+#include <cmntype/http/router.h>
+#include <cmntype/http/router_registry.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+http::Context MakeContext(beast_http::verb method, std::string_view body)
+{
+  return http::Context{method,
+                       [body](const http::HttpRequest& request) {
+                         return http::MakeResponse(request, beast_http::status::ok, "text/plain", "UTF-8", body);
+                       },
+                       {}};
+}
+
+std::string Call(const http::Router::Match& match)
+{
+  EXPECT_NE(match.context, nullptr);
+  if (!match.context)
+  {
+    return {};
+  }
+  return match.context->handler(http::HttpRequest{}).body();
+}
+}  // namespace
+
+TEST(Router, StaticRoutes)
+{
+  http::Router router;
+  router.Add("/geo", MakeContext(beast_http::verb::get, "geo"));
+  router.Add("/geo/search", MakeContext(beast_http::verb::get, "search"));
+  router.Add("/geocoder", MakeContext(beast_http::verb::get, "geocoder"));
+  router.Add("/g", MakeContext(beast_http::verb::get, "g"));
+
+  ASSERT_EQ(router.Size(), 4);
+  ASSERT_EQ(Call(router.Find("/geo", beast_http::verb::get)), "geo");
+  ASSERT_EQ(Call(router.Find("/geo/search", beast_http::verb::get)), "search");
+  ASSERT_EQ(Call(router.Find("/geocoder", beast_http::verb::get)), "geocoder");
+  ASSERT_EQ(Call(router.Find("/g", beast_http::verb::get)), "g");
+  ASSERT_EQ(Call(router.Find("/geo/search?query=moscow", beast_http::verb::get)), "search");
+
+  ASSERT_EQ(router.Find("/ge", beast_http::verb::get).context, nullptr);
+  ASSERT_EQ(router.Find("/geo/", beast_http::verb::get).context, nullptr);
+  ASSERT_EQ(router.Find("/geocoders", beast_http::verb::get).context, nullptr);
+}
+
+TEST(Router, Methods)
+{
+  http::Router router;
+  router.Add("/geo", MakeContext(beast_http::verb::get, "get"));
+  router.Add("/geo", MakeContext(beast_http::verb::post, "post"));
+  router.Add("/geo", MakeContext(beast_http::verb::post, "replaced"));
+
+  ASSERT_EQ(router.Size(), 2);
+  ASSERT_EQ(Call(router.Find("/geo", beast_http::verb::get)), "get");
+  ASSERT_EQ(Call(router.Find("/geo", beast_http::verb::post)), "replaced");
+
+  const auto match = router.Find("/geo", beast_http::verb::delete_);
+  ASSERT_EQ(match.context, nullptr);
+  ASSERT_TRUE(match.methodNotAllowed);
+  ASSERT_FALSE(router.Find("/unknown", beast_http::verb::get).methodNotAllowed);
+}
+
+TEST(Router, Params)
+{
+  http::Router router;
+  router.Add("/geo/{id}", MakeContext(beast_http::verb::get, "id"));
+  router.Add("/geo/{id}/address/{type}", MakeContext(beast_http::verb::get, "address"));
+  router.Add("/geo/search", MakeContext(beast_http::verb::get, "search"));
+
+  auto match = router.Find("/geo/42", beast_http::verb::get);
+  ASSERT_EQ(Call(match), "id");
+  ASSERT_EQ(match.params.size(), 1);
+  ASSERT_EQ(match.params[0].name, "id");
+  ASSERT_EQ(match.params[0].value, "42");
+
+  match = router.Find("/geo/42/address/full?lang=ru", beast_http::verb::get);
+  ASSERT_EQ(Call(match), "address");
+  ASSERT_EQ(match.params.size(), 2);
+  ASSERT_EQ(match.params[1].name, "type");
+  ASSERT_EQ(match.params[1].value, "full");
+
+  match = router.Find("/geo/search", beast_http::verb::get);
+  ASSERT_EQ(Call(match), "search");
+  ASSERT_TRUE(match.params.empty());
+
+  ASSERT_EQ(Call(router.Find("/geo/searching", beast_http::verb::get)), "id");
+  ASSERT_EQ(router.Find("/geo/", beast_http::verb::get).context, nullptr);
+  ASSERT_EQ(router.Find("/geo/42/address", beast_http::verb::get).context, nullptr);
+}
+
+TEST(Router, PrefixRoutes)
+{
+  http::Router router;
+  router.Add("/static/*", MakeContext(beast_http::verb::get, "static"));
+  router.Add("/static/index.html", MakeContext(beast_http::verb::get, "index"));
+
+  auto match = router.Find("/static/css/main.css", beast_http::verb::get);
+  ASSERT_EQ(Call(match), "static");
+  ASSERT_EQ(match.params.size(), 1);
+  ASSERT_EQ(match.params[0].value, "css/main.css");
+
+  ASSERT_EQ(Call(router.Find("/static/index.html", beast_http::verb::get)), "index");
+  ASSERT_EQ(Call(router.Find("/static/", beast_http::verb::get)), "static");
+  ASSERT_EQ(router.Find("/static", beast_http::verb::get).context, nullptr);
+}
+
+TEST(Router, MethodFallback)
+{
+  http::Router router;
+  router.Add("/geo/list", MakeContext(beast_http::verb::get, "list"));
+  router.Add("/geo/{id}", MakeContext(beast_http::verb::post, "id"));
+  router.Add("/static/index.html", MakeContext(beast_http::verb::get, "index"));
+  router.Add("/static/*", MakeContext(beast_http::verb::head, "static"));
+
+  ASSERT_EQ(Call(router.Find("/geo/list", beast_http::verb::get)), "list");
+
+  // the static route has no such method, the parameter route is matched
+  auto match = router.Find("/geo/list", beast_http::verb::post);
+  ASSERT_EQ(Call(match), "id");
+  ASSERT_EQ(match.params.size(), 1);
+  ASSERT_EQ(match.params[0].value, "list");
+
+  match = router.Find("/static/index.html", beast_http::verb::head);
+  ASSERT_EQ(Call(match), "static");
+  ASSERT_EQ(match.params[0].value, "index.html");
+
+  match = router.Find("/geo/list", beast_http::verb::delete_);
+  ASSERT_EQ(match.context, nullptr);
+  ASSERT_TRUE(match.methodNotAllowed);
+  ASSERT_TRUE(match.params.empty());
+}
+
+TEST(Router, InvalidRoutes)
+{
+  http::Router router;
+  router.Add("/geo/{id}", MakeContext(beast_http::verb::get, "id"));
+
+  ASSERT_THROW(router.Add("geo", MakeContext(beast_http::verb::get, "")), common::error::Error);
+  ASSERT_THROW(router.Add("/geo/{}", MakeContext(beast_http::verb::get, "")), common::error::Error);
+  ASSERT_THROW(router.Add("/geo/{id", MakeContext(beast_http::verb::get, "")), common::error::Error);
+  ASSERT_THROW(router.Add("/geo/{id}.json", MakeContext(beast_http::verb::get, "")), common::error::Error);
+  ASSERT_THROW(router.Add("/geo/{name}", MakeContext(beast_http::verb::get, "")), common::error::Error);
+  ASSERT_THROW(router.Add("/static/*/index", MakeContext(beast_http::verb::get, "")), common::error::Error);
+}
+
+TEST(Router, RegistrySnapshot)
+{
+  auto registry = std::make_shared<http::RouterRegistry>();
+  registry->Add("/geo", MakeContext(beast_http::verb::get, "geo"));
+
+  http::RouterRegistry::Snapshot snapshot{registry};
+  const auto router = registry->Get();
+  ASSERT_EQ(&snapshot.Get(), router.get());
+  ASSERT_EQ(Call(snapshot.Get().Find("/geo", beast_http::verb::get)), "geo");
+
+  registry->Add("/geo", MakeContext(beast_http::verb::get, "replaced"));
+  registry->Add("/geo/{id}", MakeContext(beast_http::verb::get, "id"));
+
+  ASSERT_EQ(registry->Version(), 3);
+  ASSERT_EQ(Call(snapshot.Get().Find("/geo", beast_http::verb::get)), "replaced");
+  ASSERT_EQ(Call(snapshot.Get().Find("/geo/1", beast_http::verb::get)), "id");
+
+  // the published router is immutable
+  ASSERT_EQ(router->Size(), 1);
+  ASSERT_EQ(Call(router->Find("/geo", beast_http::verb::get)), "geo");
+}
@@ -0,0 +1,196 @@
+//! @file test_static_files.cpp
+//! @brief Define module test for static files of the http server
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+// std
+#include <fstream>
+#include <variant>
+
+// posix
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <cmntype/config.h>
+#include <cmntype/http/file_cache.h>
+#include <cmntype/http/static_files.h>
+
+namespace http = common::http;
+namespace beast_http = boost::beast::http;
+
+namespace
+{
+class StaticFilesTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    root_ = filesystem::temp_directory_path() / ("cmntype_static_" + std::to_string(::getpid()));
+    filesystem::create_directories(root_ / "dir");
+    Write(root_ / "file.txt", "0123456789");
+    Write(root_ / "dir" / "index.html", "<html/>");
+  }
+
+  void TearDown() override
+  {
+    filesystem::remove_all(root_);
+  }
+
+  static void Write(const filesystem::path& path, const std::string& content)
+  {
+    std::ofstream file{path.string(), std::ios::binary | std::ios::trunc};
+    file << content;
+  }
+
+  static http::HttpRequest MakeRequest(beast_http::verb method = beast_http::verb::get)
+  {
+    http::HttpRequest request{method, "/", 11};
+    return request;
+  }
+
+  filesystem::path root_;
+};
+}  // namespace
+
+TEST_F(StaticFilesTest, Full)
+{
+  http::StaticFiles files{root_, {}};
+
+  auto reply = files.Serve(MakeRequest(), "file.txt");
+  ASSERT_TRUE(std::holds_alternative<http::FileResponse>(reply));
+
+  const auto& response = std::get<http::FileResponse>(reply);
+  ASSERT_EQ(response.header.result(), beast_http::status::ok);
+  ASSERT_EQ(response.offset, 0u);
+  ASSERT_EQ(response.size, 10u);
+  ASSERT_EQ(response.header[beast_http::field::content_type], "text/plain");
+  ASSERT_EQ(response.header[beast_http::field::content_length], "10");
+  ASSERT_EQ(response.header[beast_http::field::etag], response.file->ETag());
+
+  reply = files.Serve(MakeRequest(), "dir/");
+  ASSERT_TRUE(std::holds_alternative<http::FileResponse>(reply));
+  ASSERT_EQ(std::get<http::FileResponse>(reply).header[beast_http::field::content_type], "text/html");
+
+  reply = files.Serve(MakeRequest(beast_http::verb::head), "file.txt");
+  ASSERT_EQ(std::get<http::FileResponse>(reply).size, 0u);
+  ASSERT_EQ(std::get<http::FileResponse>(reply).header[beast_http::field::content_length], "10");
+}
+
+TEST_F(StaticFilesTest, NotFound)
+{
+  http::StaticFiles files{root_, {}};
+
+  auto reply = files.Serve(MakeRequest(), "missing.txt");
+  ASSERT_EQ(std::get<http::HttpResponse>(reply).result(), beast_http::status::not_found);
+
+  reply = files.Serve(MakeRequest(), "dir");
+  ASSERT_EQ(std::get<http::HttpResponse>(reply).result(), beast_http::status::not_found);
+
+  for (const auto* path : {"../file.txt", "dir/../../file.txt", "%2e%2e/file.txt", "dir%5cfile.txt", "file.txt%00", "%zz"})
+  {
+    reply = files.Serve(MakeRequest(), path);
+    ASSERT_EQ(std::get<http::HttpResponse>(reply).result(), beast_http::status::bad_request) << path;
+  }
+}
+
+TEST_F(StaticFilesTest, Range)
+{
+  http::StaticFiles files{root_, {}};
+
+  const std::vector<std::tuple<std::string, std::uint64_t, std::uint64_t, std::string>> ranges{
+      {"bytes=2-5", 2, 4, "bytes 2-5/10"},
+      {"bytes=7-", 7, 3, "bytes 7-9/10"},
+      {"bytes=-4", 6, 4, "bytes 6-9/10"},
+      {"bytes=5-100", 5, 5, "bytes 5-9/10"}};
+
+  for (const auto& [range, offset, size, contentRange] : ranges)
+  {
+    auto request = MakeRequest();
+    request.set(beast_http::field::range, range);
+
+    const auto reply = files.Serve(request, "file.txt");
+    const auto& response = std::get<http::FileResponse>(reply);
+    ASSERT_EQ(response.header.result(), beast_http::status::partial_content) << range;
+    ASSERT_EQ(response.offset, offset) << range;
+    ASSERT_EQ(response.size, size) << range;
+    ASSERT_EQ(response.header[beast_http::field::content_range], contentRange) << range;
+  }
+
+  auto request = MakeRequest();
+  request.set(beast_http::field::range, "bytes=10-");
+  auto reply = files.Serve(request, "file.txt");
+  ASSERT_EQ(std::get<http::HttpResponse>(reply).result(), beast_http::status::range_not_satisfiable);
+  ASSERT_EQ(std::get<http::HttpResponse>(reply)[beast_http::field::content_range], "bytes */10");
+
+  // the multiple ranges and the changed file are served entirely
+  request.set(beast_http::field::range, "bytes=0-1,4-5");
+  reply = files.Serve(request, "file.txt");
+  ASSERT_EQ(std::get<http::FileResponse>(reply).header.result(), beast_http::status::ok);
+
+  request.set(beast_http::field::range, "bytes=0-1");
+  request.set(beast_http::field::if_range, "\"other\"");
+  reply = files.Serve(request, "file.txt");
+  ASSERT_EQ(std::get<http::FileResponse>(reply).header.result(), beast_http::status::ok);
+}
+
+TEST_F(StaticFilesTest, NotModified)
+{
+  http::StaticFiles files{root_, {}};
+
+  const auto reply = files.Serve(MakeRequest(), "file.txt");
+  const auto& file = *std::get<http::FileResponse>(reply).file;
+
+  auto request = MakeRequest();
+  request.set(beast_http::field::if_none_match, file.ETag());
+  ASSERT_EQ(std::get<http::HttpResponse>(files.Serve(request, "file.txt")).result(), beast_http::status::not_modified);
+
+  request = MakeRequest();
+  request.set(beast_http::field::if_modified_since, file.LastModified());
+  ASSERT_EQ(std::get<http::HttpResponse>(files.Serve(request, "file.txt")).result(), beast_http::status::not_modified);
+
+  // any later date, the earlier and invalid dates are ignored
+  request = MakeRequest();
+  request.set(beast_http::field::if_modified_since, "Fri, 01 Jan 2100 00:00:00 GMT");
+  ASSERT_EQ(std::get<http::HttpResponse>(files.Serve(request, "file.txt")).result(), beast_http::status::not_modified);
+
+  request = MakeRequest();
+  request.set(beast_http::field::if_modified_since, "Thu, 01 Jan 1970 00:00:00 GMT");
+  ASSERT_TRUE(std::holds_alternative<http::FileResponse>(files.Serve(request, "file.txt")));
+
+  request = MakeRequest();
+  request.set(beast_http::field::if_modified_since, "tomorrow");
+  ASSERT_TRUE(std::holds_alternative<http::FileResponse>(files.Serve(request, "file.txt")));
+
+  request = MakeRequest();
+  request.set(beast_http::field::if_none_match, "\"other\"");
+  ASSERT_TRUE(std::holds_alternative<http::FileResponse>(files.Serve(request, "file.txt")));
+}
+
+TEST_F(StaticFilesTest, FileCache)
+{
+  const auto path = (root_ / "file.txt").string();
+
+  http::FileCache cache{1, std::chrono::milliseconds{0}};
+  boost::beast::error_code ec;
+
+  const auto first = cache.Open(path, ec);
+  ASSERT_FALSE(ec);
+  ASSERT_EQ(cache.Open(path, ec), first);
+  ASSERT_EQ(cache.Size(), 1u);
+
+  // the changed file is reopened after the revalidation
+  Write(path, "01234567890123456789");
+  const auto second = cache.Open(path, ec);
+  ASSERT_NE(second, first);
+  ASSERT_EQ(second->Size(), 20u);
+
+  // the least recently used file is evicted
+  cache.Open((root_ / "dir" / "index.html").string(), ec);
+  ASSERT_EQ(cache.Size(), 1u);
+  ASSERT_NE(cache.Open(path, ec), second);
+
+  cache.Open((root_ / "missing").string(), ec);
+  ASSERT_TRUE(ec);
+}
@@ -0,0 +1,93 @@
+//! @file test_timer_wheel.cpp
+//! @brief Define module test for timer wheel of the sessions timeouts
+//! @author Bobrov A.E.
+//! @date 18.10.2026
+//! @copyright (c) Bobrov A.E.
+
+#include <gtest/gtest.h>
+
+#include <cmntype/http/timer_wheel.h>
+
+namespace http = common::http;
+
+namespace
+{
+using namespace std::chrono_literals;
+
+struct Client : http::TimerWheel::Client
+{
+  void OnExpire(http::TimerWheel::Tick deadline) override
+  {
+    if (Deadline() == deadline)
+    {
+      expired++;
+    }
+  }
+
+  int expired{0};
+};
+}  // namespace
+
+TEST(TimerWheel, Expire)
+{
+  boost::asio::io_context io;
+  http::TimerWheel wheel{io, 10ms, 16};
+  auto client = std::make_shared<Client>();
+
+  wheel.Start();
+  wheel.Arm(client, 50ms);
+
+  io.run_for(30ms);
+  ASSERT_EQ(client->expired, 0);
+
+  io.run_for(100ms);
+  ASSERT_EQ(client->expired, 1);
+  ASSERT_EQ(wheel.Size(), 0u);
+}
+
+TEST(TimerWheel, Rearm)
+{
+  boost::asio::io_context io;
+  http::TimerWheel wheel{io, 10ms, 4};
+  auto client = std::make_shared<Client>();
+
+  wheel.Start();
+
+  // the deadline is extended by the progress, the deadline is longer than the round of the wheel
+  for (int i = 0; i < 10; i++)
+  {
+    wheel.Arm(client, 60ms);
+    io.run_for(20ms);
+  }
+  ASSERT_EQ(client->expired, 0);
+
+  // the shorter deadline replaces the longer one
+  wheel.Arm(client, 1000ms);
+  wheel.Arm(client, 20ms);
+  io.run_for(100ms);
+  ASSERT_EQ(client->expired, 1);
+}
+
+TEST(TimerWheel, Disarm)
+{
+  boost::asio::io_context io;
+  http::TimerWheel wheel{io, 10ms, 16};
+  auto client = std::make_shared<Client>();
+  auto released = std::make_shared<Client>();
+
+  wheel.Start();
+  wheel.Arm(client, 20ms);
+  wheel.Arm(released, 20ms);
+  http::TimerWheel::Disarm(*client);
+  released.reset();
+
+  io.run_for(100ms);
+  ASSERT_EQ(client->expired, 0);
+  ASSERT_EQ(wheel.Size(), 0u);
+
+  // the stopped wheel doesn't tick
+  wheel.Stop();
+  wheel.Arm(client, 10ms);
+  io.run_for(50ms);
+  ASSERT_EQ(client->expired, 0);
+}